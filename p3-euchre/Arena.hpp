@@ -0,0 +1,61 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+/* Arena.hpp
+ *
+ * A bump allocator for many small objects that all die together, such as
+ * the nodes of a search tree.  Objects are carved out of fixed-size
+ * blocks; reset frees them all at once and keeps the blocks, so a tree
+ * rebuilt to the same size never touches the heap again.  Objects never
+ * move, so pointers to them stay valid until reset.
+ */
+
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+template <typename T>
+class Arena {
+  // reset never runs destructors
+  static_assert(std::is_trivially_destructible<T>::value,
+                "Arena objects must be trivially destructible");
+
+public:
+  //REQUIRES block_size_in > 0
+  //EFFECTS Initializes an empty arena that allocates block_size_in
+  //  objects at a time
+  explicit Arena(std::size_t block_size_in = 4096)
+    : block_size(block_size_in), count(0) {
+    assert(block_size > 0);
+  }
+
+  //EFFECTS Returns a new value-initialized object, valid until reset
+  T * make() {
+    const std::size_t block = count / block_size;
+    if (block == blocks.size()) {
+      blocks.emplace_back(new T[block_size]);
+    }
+    T *object = &blocks[block][count % block_size];
+    *object = T();
+    ++count;
+    return object;
+  }
+
+  //EFFECTS Frees every object made since the last reset
+  void reset() { count = 0; }
+
+  //EFFECTS Returns the number of objects made since the last reset
+  std::size_t size() const { return count; }
+
+  //EFFECTS Returns the number of objects the arena has room for
+  std::size_t capacity() const { return blocks.size() * block_size; }
+
+private:
+  std::vector<std::unique_ptr<T[]>> blocks;
+  std::size_t block_size;
+  std::size_t count;
+};
+
+#endif // ARENA_HPP
@@ -0,0 +1,52 @@
+#include "Arena.hpp"
+#include "unit_test_framework.hpp"
+
+#include <vector>
+
+using namespace std;
+
+struct Item {
+    int value;
+    Item *next;
+};
+
+TEST(test_arena_make) {
+    Arena<Item> arena(3);
+    ASSERT_EQUAL(arena.size(), 0u);
+    vector<Item*> items;
+    for (int i = 0; i < 10; ++i) {
+        Item *item = arena.make();
+        ASSERT_EQUAL(item->value, 0);
+        ASSERT_TRUE(item->next == nullptr);
+        item->value = i;
+        items.push_back(item);
+    }
+    ASSERT_EQUAL(arena.size(), 10u);
+    ASSERT_EQUAL(arena.capacity(), 12u);
+    // objects never move as the arena grows
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_EQUAL(items[i]->value, i);
+    }
+}
+
+// After a reset the same memory is handed out again, cleared
+TEST(test_arena_reset) {
+    Arena<Item> arena(4);
+    Item *first = arena.make();
+    first->value = 7;
+    for (int i = 0; i < 6; ++i) {
+        arena.make();
+    }
+    arena.reset();
+    ASSERT_EQUAL(arena.size(), 0u);
+    ASSERT_EQUAL(arena.capacity(), 8u);
+    Item *again = arena.make();
+    ASSERT_TRUE(again == first);
+    ASSERT_EQUAL(again->value, 0);
+    for (int i = 0; i < 7; ++i) {
+        arena.make();
+    }
+    ASSERT_EQUAL(arena.capacity(), 8u);
+}
+
+TEST_MAIN()
@@ -0,0 +1,148 @@
+#include "Bench.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <ctime>
+#include <iomanip>
+#include <ostream>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+double now_ns() {
+  return chrono::duration<double, nano>(
+    chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// EFFECTS: Prints text as a JSON string
+void print_string(ostream &os, const string &text) {
+  os << '"';
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      os << '\\';
+    }
+    os << c;
+  }
+  os << '"';
+}
+
+// One timed repetition, per operation
+struct Sample {
+  double ns;
+  double cycles;
+  long ops;
+};
+
+Sample time_rep(const BenchBody &body, long iterations) {
+  const uint64_t cycles_start = Bench_cycles();
+  const double start = now_ns();
+  const long ops = max(1L, body(iterations));
+  const double ns = now_ns() - start;
+  const uint64_t cycles = Bench_cycles() - cycles_start;
+  return {ns / ops, double(cycles) / ops, ops};
+}
+
+// EFFECTS: Returns an iteration count whose repetition takes at least
+//          min_ns, doubling from 1
+long calibrate(const BenchBody &body, double min_ns) {
+  long iterations = 1;
+  while (iterations < (1L << 40)) {
+    const double start = now_ns();
+    body(iterations);
+    if (now_ns() - start >= min_ns) {
+      break;
+    }
+    iterations *= 2;
+  }
+  return iterations;
+}
+
+} // namespace
+
+BenchSuite::BenchSuite(const BenchOptions &options_in) : options(options_in) {}
+
+void BenchSuite::run(const string &name, const BenchBody &body) {
+  if (name.find(options.filter) == string::npos) {
+    return;
+  }
+  const long iterations = calibrate(body, options.min_rep_ns);
+  for (int i = 0; i < options.warmup; ++i) {
+    body(iterations);
+  }
+  BenchStats result;
+  vector<double> ns;
+  vector<double> cycles;
+  for (int i = 0; i < options.reps; ++i) {
+    const Sample sample = time_rep(body, iterations);
+    ns.push_back(sample.ns);
+    cycles.push_back(sample.cycles);
+    result.ops_per_rep = sample.ops;
+  }
+  result.name = name;
+  result.reps = options.reps;
+  if (!ns.empty()) {
+    result.median_ns = Bench_percentile(ns, 0.5);
+    result.p99_ns = Bench_percentile(ns, 0.99);
+    result.min_ns = Bench_percentile(ns, 0);
+    if (Bench_cycles() != 0) {
+      result.cycles_per_op = Bench_percentile(cycles, 0.5);
+    }
+  }
+  stats.push_back(result);
+}
+
+void BenchSuite::print_table(ostream &os) const {
+  os << left << setw(40) << "benchmark" << right << setw(12) << "median ns"
+     << setw(12) << "p99 ns" << setw(12) << "cycles" << '\n';
+  os << fixed << setprecision(2);
+  for (const BenchStats &s : stats) {
+    os << left << setw(40) << s.name << right << setw(12) << s.median_ns
+       << setw(12) << s.p99_ns << setw(12) << s.cycles_per_op << '\n';
+  }
+  os << defaultfloat;
+}
+
+void BenchSuite::print_json(ostream &os) const {
+  os << "{\n  \"compiler\": ";
+  print_string(os, __VERSION__);
+#ifdef __OPTIMIZE__
+  os << ",\n  \"optimized\": true";
+#else
+  os << ",\n  \"optimized\": false";
+#endif
+  os << ",\n  \"time\": " << time(nullptr) << ",\n  \"benchmarks\": [";
+  for (size_t i = 0; i < stats.size(); ++i) {
+    const BenchStats &s = stats[i];
+    os << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+    print_string(os, s.name);
+    os << ", \"ops_per_rep\": " << s.ops_per_rep << ", \"reps\": " << s.reps
+       << ", \"median_ns\": " << s.median_ns << ", \"p99_ns\": " << s.p99_ns
+       << ", \"min_ns\": " << s.min_ns << ", \"cycles_per_op\": ";
+    if (s.cycles_per_op < 0) {
+      os << "null";
+    } else {
+      os << s.cycles_per_op;
+    }
+    os << '}';
+  }
+  os << "\n  ]\n}\n";
+}
+
+double Bench_percentile(vector<double> &samples, double fraction) {
+  sort(samples.begin(), samples.end());
+  const double rank = ceil(fraction * samples.size());
+  const size_t index = rank < 1 ? 0 : size_t(rank) - 1;
+  return samples[min(index, samples.size() - 1)];
+}
+
+uint64_t Bench_cycles() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return 0;
+#endif
+}
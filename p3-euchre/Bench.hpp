@@ -0,0 +1,87 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+/* Bench.hpp
+ *
+ * A small harness for timing the hot paths.  Each benchmark is a function
+ * that does an operation a given number of times.  The harness finds an
+ * iteration count that makes one repetition take at least min_rep_ns,
+ * runs some warmup repetitions that are thrown away, and then times the
+ * repetitions that count.  It reports the median and 99th percentile time
+ * per operation and, where the CPU has a time stamp counter, the median
+ * count of reference cycles per operation.
+ *
+ * Results print as a table for people and as JSON for scripts that track
+ * regressions from build to build.
+ */
+
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+struct BenchOptions {
+  int warmup = 3;                 // repetitions run and thrown away
+  // repetitions timed; with fewer than 100 the 99th percentile is the
+  // slowest repetition
+  int reps = 101;
+  double min_rep_ns = 2e6;        // shortest repetition worth timing
+  std::string filter;             // run only names containing this
+};
+
+// The timings of one benchmark
+struct BenchStats {
+  std::string name;
+  long ops_per_rep = 0;
+  int reps = 0;
+  double median_ns = 0;           // per operation
+  double p99_ns = 0;
+  double min_ns = 0;
+  double cycles_per_op = -1;      // -1 without a time stamp counter
+};
+
+// A benchmark body: does its operation about iterations times and returns
+// how many operations it did
+using BenchBody = std::function<long(long iterations)>;
+
+class BenchSuite {
+public:
+  //EFFECTS Initializes a suite that has run nothing
+  explicit BenchSuite(const BenchOptions &options_in);
+
+  //EFFECTS Times body as the benchmark called name, unless the filter
+  //  leaves it out, and adds its stats to results
+  void run(const std::string &name, const BenchBody &body);
+
+  //EFFECTS Returns the stats of every benchmark run so far, in order
+  const std::vector<BenchStats> & results() const { return stats; }
+
+  //EFFECTS Prints the results as a table, one benchmark a line
+  void print_table(std::ostream &os) const;
+
+  //EFFECTS Prints the results and the build they came from as JSON
+  void print_json(std::ostream &os) const;
+
+private:
+  BenchOptions options;
+  std::vector<BenchStats> stats;
+};
+
+//REQUIRES samples is not empty, 0 <= fraction <= 1
+//MODIFIES samples
+//EFFECTS Returns the sample at fraction of the way up the sorted samples
+//  (nearest rank), so 0.5 is the median and 0.99 the 99th percentile
+double Bench_percentile(std::vector<double> &samples, double fraction);
+
+//EFFECTS Returns the time stamp counter, or 0 if the CPU has none
+std::uint64_t Bench_cycles();
+
+//EFFECTS Makes the compiler assume value is used, so the work that made
+//  it is not optimized away
+template <typename T>
+inline void Bench_keep(const T &value) {
+  __asm__ __volatile__("" : : "g"(&value) : "memory");
+}
+
+#endif // BENCH_HPP
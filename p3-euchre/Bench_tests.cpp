@@ -0,0 +1,95 @@
+#include "Bench.hpp"
+#include "unit_test_framework.hpp"
+
+#include <sstream>
+
+using namespace std;
+
+static BenchOptions quick_options() {
+    BenchOptions options;
+    options.warmup = 1;
+    options.reps = 5;
+    options.min_rep_ns = 1e4;
+    return options;
+}
+
+TEST(test_percentile_nearest_rank) {
+    vector<double> samples = {5, 1, 4, 2, 3};
+    ASSERT_EQUAL(Bench_percentile(samples, 0.5), 3);
+    ASSERT_EQUAL(Bench_percentile(samples, 0), 1);
+    ASSERT_EQUAL(Bench_percentile(samples, 0.99), 5);
+    ASSERT_EQUAL(Bench_percentile(samples, 1), 5);
+    vector<double> hundred;
+    for (int i = 100; i >= 1; --i) {
+        hundred.push_back(i);
+    }
+    ASSERT_EQUAL(Bench_percentile(hundred, 0.99), 99);
+    ASSERT_EQUAL(Bench_percentile(hundred, 0.5), 50);
+}
+
+// The default repetitions are enough that p99 is not just the slowest one
+TEST(test_default_reps_p99_below_max) {
+    const int reps = BenchOptions().reps;
+    vector<double> samples;
+    for (int i = 1; i <= reps; ++i) {
+        samples.push_back(i);
+    }
+    ASSERT_TRUE(Bench_percentile(samples, 0.99) < reps);
+    ASSERT_EQUAL(Bench_percentile(samples, 0.5), (reps + 1) / 2);
+}
+
+TEST(test_run_counts_ops) {
+    BenchSuite suite(quick_options());
+    long total = 0;
+    suite.run("sum", [&total](long iterations) {
+        // three operations an iteration
+        for (long i = 0; i < 3 * iterations; ++i) {
+            total += i;
+            Bench_keep(total);
+        }
+        return 3 * iterations;
+    });
+    ASSERT_EQUAL(suite.results().size(), size_t(1));
+    const BenchStats &stats = suite.results()[0];
+    ASSERT_EQUAL(stats.name, "sum");
+    ASSERT_EQUAL(stats.reps, 5);
+    ASSERT_EQUAL(stats.ops_per_rep % 3, 0);
+    ASSERT_TRUE(stats.min_ns <= stats.median_ns);
+    ASSERT_TRUE(stats.median_ns <= stats.p99_ns);
+    ASSERT_TRUE(stats.median_ns > 0);
+    ASSERT_TRUE(stats.cycles_per_op != 0);
+}
+
+TEST(test_filter) {
+    BenchOptions options = quick_options();
+    options.filter = "Pack";
+    BenchSuite suite(options);
+    int calls = 0;
+    auto body = [&calls](long iterations) {
+        ++calls;
+        return iterations;
+    };
+    suite.run("Card_less", body);
+    ASSERT_EQUAL(calls, 0);
+    suite.run("Pack::deal_one", body);
+    ASSERT_TRUE(calls > 0);
+    ASSERT_EQUAL(suite.results().size(), size_t(1));
+    ASSERT_EQUAL(suite.results()[0].name, "Pack::deal_one");
+}
+
+TEST(test_json) {
+    BenchSuite suite(quick_options());
+    suite.run("say \"hi\"", [](long iterations) { return iterations; });
+    suite.run("second", [](long iterations) { return iterations; });
+    ostringstream json;
+    suite.print_json(json);
+    const string text = json.str();
+    ASSERT_TRUE(text.find("\"name\": \"say \\\"hi\\\"\"") != string::npos);
+    ASSERT_TRUE(text.find("\"name\": \"second\"") != string::npos);
+    ASSERT_TRUE(text.find("\"median_ns\": ") != string::npos);
+    ASSERT_TRUE(text.find("\"compiler\": ") != string::npos);
+    ASSERT_EQUAL(text.front(), '{');
+    ASSERT_EQUAL(text[text.size() - 2], '}');
+}
+
+TEST_MAIN()
@@ -5,6 +5,47 @@
 
 using namespace std;
 
+// 判断 c 是否为空白字符，与 isspace 相同但不受 locale 影响
+static bool is_space(char c) {
+  return c == ' ' || c == '\n' || c == '\t' || c == '\r' ||
+         c == '\v' || c == '\f';
+}
+
+// 流输入用的单词缓冲区，比最长的名字长，所以有效输入不会被截断
+constexpr size_t WORD_BUFFER_SIZE = 16;
+
+// EFFECTS: 像 is >> str 一样从流中读取一个单词，但存进 buffer 而不是
+//   分配一个 string。单词放不下 buffer 时读取失败。
+static bool read_word(std::istream &is, char (&buffer)[WORD_BUFFER_SIZE],
+                      std::string_view &word) {
+  std::istream::sentry ok(is);
+  if (!ok) {
+    return false;
+  }
+  std::streambuf *buf = is.rdbuf();
+  size_t n = 0;
+  for (int c = buf->sgetc(); ; c = buf->snextc()) {
+    if (c == std::istream::traits_type::eof()) {
+      is.setstate(std::ios_base::eofbit);
+      break;
+    }
+    if (is_space(static_cast<char>(c))) {
+      break;
+    }
+    if (n == WORD_BUFFER_SIZE) {
+      is.setstate(std::ios_base::failbit);
+      return false;
+    }
+    buffer[n++] = static_cast<char>(c);
+  }
+  if (n == 0) {
+    is.setstate(std::ios_base::failbit);
+    return false;
+  }
+  word = std::string_view(buffer, n);
+  return true;
+}
+
 // Rank 操作符的实现 - 不要更改
 // RANK_NAMES 数组存储所有的牌面值名称
 constexpr const char *const RANK_NAMES[] = {
@@ -25,14 +66,12 @@ constexpr const char *const RANK_NAMES[] = {
 
 // REQUIRES: str 表示一个有效的牌面值 ("Two", "Three", ..., "Ace")
 // EFFECTS: 返回与字符串对应的 Rank，例如 "Two" -> TWO
-Rank string_to_rank(const std::string &str) {
-  for (int r = TWO; r <= ACE; ++r) {
-    if (str == RANK_NAMES[r]) {
-      return static_cast<Rank>(r);
-    }
-  }
-  assert(false); // 输入字符串不匹配任何牌面值
-  return {};
+Rank string_to_rank(std::string_view str) {
+  Rank rank = TWO;
+  bool found = parse_rank(str, rank);
+  assert(found); // 输入字符串不匹配任何牌面值
+  (void)found;
+  return rank;
 }
 
 // EFFECTS: 将 Rank 输出到流，例如 "Two"
@@ -44,8 +83,9 @@ std::ostream &operator<<(std::ostream &os, Rank rank) {
 // REQUIRES: 输入必须是一个有效的牌面值
 // EFFECTS: 从流中读取一个 Rank，例如 "Two" -> TWO
 std::istream &operator>>(std::istream &is, Rank &rank) {
-  string str;
-  if (is >> str) {
+  char buffer[WORD_BUFFER_SIZE];
+  std::string_view str;
+  if (read_word(is, buffer, str)) {
     rank = string_to_rank(str);
   }
   return is;
@@ -60,16 +100,82 @@ constexpr const char *const SUIT_NAMES[] = {
   "Diamonds", // DIAMONDS
 };
 
-// REQUIRES: str 表示一个有效的花色 ("Spades", "Hearts", "Clubs", 或 "Diamonds")
-// EFFECTS: 返回与字符串对应的 Suit，例如 "Clubs" -> CLUBS
-Suit string_to_suit(const std::string &str) {
-  for (int s = SPADES; s <= DIAMONDS; ++s) {
-    if (str == SUIT_NAMES[s]) {
-      return static_cast<Suit>(s);
+// 牌面值和花色名字的完美哈希。名字的长度和前两个字母算出 0..31 之间的
+// 槽位，13 个牌面值各占一个槽位，4 个花色也各占一个槽位，所以查找时只需
+// 算一次哈希，再比较一次字符串。槽位是否冲突在编译期检查。
+constexpr int NAME_HASH_SIZE = 32;
+constexpr size_t MIN_NAME_LENGTH = 3; // "Two", "Six", "Ten", "Ace"
+constexpr size_t MAX_NAME_LENGTH = 8; // "Diamonds"
+
+// REQUIRES: str.size() >= 2
+constexpr int name_hash(std::string_view str) {
+  return (3 * str[0] + 6 * str[1] + static_cast<int>(str.size()))
+         & (NAME_HASH_SIZE - 1);
+}
+
+struct NameHashTable {
+  signed char index[NAME_HASH_SIZE]; // 名字在表中的下标，-1 表示空槽位
+};
+
+template <size_t N>
+constexpr NameHashTable make_name_hash(const char *const (&names)[N]) {
+  NameHashTable table = {};
+  for (int h = 0; h < NAME_HASH_SIZE; ++h) {
+    table.index[h] = -1;
+  }
+  for (size_t i = 0; i < N; ++i) {
+    int h = name_hash(names[i]);
+    if (table.index[h] != -1) {
+      throw "name_hash collision"; // 在编译期求值时会变成编译错误
     }
+    table.index[h] = static_cast<signed char>(i);
   }
-  assert(false); // 输入字符串不匹配任何花色
-  return {};
+  return table;
+}
+
+constexpr NameHashTable RANK_HASH = make_name_hash(RANK_NAMES);
+constexpr NameHashTable SUIT_HASH = make_name_hash(SUIT_NAMES);
+
+// EFFECTS: 如果 str 是 names 中的名字，返回它的下标，否则返回 -1
+template <size_t N>
+static int find_name(std::string_view str, const NameHashTable &table,
+                     const char *const (&names)[N]) {
+  if (str.size() < MIN_NAME_LENGTH || str.size() > MAX_NAME_LENGTH) {
+    return -1;
+  }
+  int i = table.index[name_hash(str)];
+  if (i < 0 || str != names[i]) {
+    return -1;
+  }
+  return i;
+}
+
+bool parse_rank(std::string_view str, Rank &rank) {
+  int r = find_name(str, RANK_HASH, RANK_NAMES);
+  if (r < 0) {
+    return false;
+  }
+  rank = static_cast<Rank>(r);
+  return true;
+}
+
+bool parse_suit(std::string_view str, Suit &suit) {
+  int s = find_name(str, SUIT_HASH, SUIT_NAMES);
+  if (s < 0) {
+    return false;
+  }
+  suit = static_cast<Suit>(s);
+  return true;
+}
+
+// REQUIRES: str 表示一个有效的花色 ("Spades", "Hearts", "Clubs", 或 "Diamonds")
+// EFFECTS: 返回与字符串对应的 Suit，例如 "Clubs" -> CLUBS
+Suit string_to_suit(std::string_view str) {
+  Suit suit = SPADES;
+  bool found = parse_suit(str, suit);
+  assert(found); // 输入字符串不匹配任何花色
+  (void)found;
+  return suit;
 }
 
 // EFFECTS: 将 Suit 输出到流，例如 "Spades"
@@ -81,32 +187,15 @@ std::ostream &operator<<(std::ostream &os, Suit suit) {
 // REQUIRES: 输入必须是一个有效的花色
 // EFFECTS: 从流中读取一个 Suit，例如 "Spades" -> SPADES
 std::istream &operator>>(std::istream &is, Suit &suit) {
-  string str;
-  if (is >> str) {
+  char buffer[WORD_BUFFER_SIZE];
+  std::string_view str;
+  if (read_word(is, buffer, str)) {
     suit = string_to_suit(str);
   }
   return is;
 }
 
 // 写下你对 Card 类的实现
-// Card 默认构造函数，初始化为 TWO of SPADES
-Card::Card()
-    : rank(TWO), suit(SPADES) {}
-
-// Card 构造函数，使用指定的 Rank 和 Suit
-Card::Card(Rank rank_in, Suit suit_in)
-    : rank(rank_in), suit(suit_in) {}
-
-// 获取牌的 Rank
-Rank Card::get_rank() const {
-  return rank;
-}
-
-// 获取牌的 Suit
-Suit Card::get_suit() const {
-  return suit;
-}
-
 // 获取牌的 Suit，如果是左 Bauer，则返回 trump
 Suit Card::get_suit(Suit trump) const {
   if (is_left_bower(trump)) {
@@ -135,22 +224,118 @@ bool Card::is_trump(Suit trump) const {
   return (suit == trump || is_left_bower(trump));
 }
 
+// 所有 52 张牌的名字，例如 "Ace of Spades"，在编译期由
+// RANK_NAMES 和 SUIT_NAMES 拼出来，按 Card_id 排列
+struct CardNameTable {
+  char text[NUM_CARDS][20];
+  unsigned char length[NUM_CARDS];
+};
+
+constexpr CardNameTable make_card_names() {
+  CardNameTable table = {};
+  for (int id = 0; id < NUM_CARDS; ++id) {
+    const char *parts[] = {RANK_NAMES[id >> 2], " of ", SUIT_NAMES[id & 3]};
+    int n = 0;
+    for (const char *part : parts) {
+      for (; *part != '\0'; ++part) {
+        table.text[id][n++] = *part;
+      }
+    }
+    table.length[id] = static_cast<unsigned char>(n);
+  }
+  return table;
+}
+
+constexpr CardNameTable CARD_NAMES = make_card_names();
+
+std::string_view Rank_name(Rank rank) {
+  return RANK_NAMES[rank];
+}
+
+std::string_view Suit_name(Suit suit) {
+  return SUIT_NAMES[suit];
+}
+
+std::string_view Card_name(const Card &card) {
+  CardId id = Card_id(card);
+  return std::string_view(CARD_NAMES.text[id], CARD_NAMES.length[id]);
+}
+
 // 重载输出运算符，将 Card 输出到流，例如 "Ace of Spades"
 std::ostream &operator<<(std::ostream &os, const Card &card) {
-  os << card.get_rank() << " of " << card.get_suit();
+  std::string_view name = Card_name(card);
+  os.write(name.data(), name.size());
   return os;
 }
 
 // 重载输入运算符，从流中读取 Card
 std::istream &operator>>(std::istream &is, Card &card) {
-  string rank_str, of_str, suit_str;
-  if (is >> rank_str >> of_str >> suit_str) {
+  char rank_buffer[WORD_BUFFER_SIZE];
+  char of_buffer[WORD_BUFFER_SIZE];
+  char suit_buffer[WORD_BUFFER_SIZE];
+  std::string_view rank_str, of_str, suit_str;
+  if (read_word(is, rank_buffer, rank_str) &&
+      read_word(is, of_buffer, of_str) &&
+      read_word(is, suit_buffer, suit_str)) {
     card.rank = string_to_rank(rank_str);
     card.suit = string_to_suit(suit_str);
   }
   return is;
 }
 
+// 跳过 text 开头的空白字符
+static void skip_space(std::string_view &text) {
+  size_t i = 0;
+  while (i < text.size() && is_space(text[i])) {
+    ++i;
+  }
+  text.remove_prefix(i);
+}
+
+// 从 text 开头取出一个单词（不含空白）
+static std::string_view take_word(std::string_view &text) {
+  skip_space(text);
+  size_t n = 0;
+  while (n < text.size() && !is_space(text[n])) {
+    ++n;
+  }
+  std::string_view word = text.substr(0, n);
+  text.remove_prefix(n);
+  return word;
+}
+
+// 从 text 开头读取一张牌，格式为 "Two of Spades"
+bool parse_card(std::string_view &text, Card &card) {
+  std::string_view rest = text;
+  Rank rank = TWO;
+  Suit suit = SPADES;
+  if (!parse_rank(take_word(rest), rank) || take_word(rest) != "of" ||
+      !parse_suit(take_word(rest), suit)) {
+    return false;
+  }
+  card = Card(rank, suit);
+  text = rest;
+  return true;
+}
+
+// 批量读取牌，不分配内存
+size_t parse_cards(std::string_view text, Card *out, size_t max_cards) {
+  size_t count = 0;
+  while (count < max_cards && parse_card(text, out[count])) {
+    ++count;
+  }
+  return count;
+}
+
+vector<Card> parse_cards(std::string_view text) {
+  vector<Card> cards;
+  Card card;
+  while (parse_card(text, card)) {
+    cards.push_back(card);
+  }
+  return cards;
+}
+
 // 重载小于运算符，根据 Rank 和 Suit 比较两张牌
 bool operator<(const Card &lhs, const Card &rhs) {
   if (lhs.get_rank() < rhs.get_rank()) {
@@ -200,54 +385,13 @@ Suit Suit_next(Suit suit) {
   }
 }
 
-// 比较两张牌的大小，考虑 Trump
+// 比较两张牌的大小，考虑 Trump；查表代替逐条判断
 bool Card_less(const Card &a, const Card &b, Suit trump) {
-  if (a.is_right_bower(trump)) {
-    return false;
-  } else if (b.is_right_bower(trump)) {
-    return true;
-  } else if (a.is_left_bower(trump)) {
-    return false;
-  } else if (b.is_left_bower(trump)) {
-    return true;
-  } else if (a.is_trump(trump) && b.is_trump(trump)) {
-    return a.get_rank() < b.get_rank();
-  } else if (a.is_trump(trump)) {
-    return false;
-  } else if (b.is_trump(trump)) {
-    return true;
-  } else {
-    if (a.get_rank() < b.get_rank()) {
-      return true;
-    } else if (a.get_rank() == b.get_rank()) {
-      return a.get_suit() < b.get_suit();
-    } else {
-      return false;
-    }
-  }
+  return Card_order(a, trump) < Card_order(b, trump);
 }
 
 // 比较两张牌的大小，考虑 Trump 和 led_card
 bool Card_less(const Card &a, const Card &b, const Card &led_card, Suit trump) {
-  if (a.is_right_bower(trump)) {
-    return false;
-  } else if (b.is_right_bower(trump)) {
-    return true;
-  } else if (a.is_left_bower(trump)) {
-    return false;
-  } else if (b.is_left_bower(trump)) {
-    return true;
-  } else if (a.is_trump(trump) && !b.is_trump(trump)) {
-    return false;
-  } else if (!a.is_trump(trump) && b.is_trump(trump)) {
-    return true;
-  } else if (a.get_suit(trump) == led_card.get_suit(trump) &&
-             b.get_suit(trump) != led_card.get_suit(trump)) {
-    return false;
-  } else if (a.get_suit(trump) != led_card.get_suit(trump) &&
-             b.get_suit(trump) == led_card.get_suit(trump)) {
-    return true;
-  } else {
-    return a < b;
-  }
+  Suit led_suit = led_card.get_suit(trump);
+  return Card_order(a, led_suit, trump) < Card_order(b, led_suit, trump);
 }
@@ -9,7 +9,10 @@
  * 2014-12-21
  */
 
+#include <cstddef>
 #include <iostream>
+#include <string_view>
+#include <vector>
 
 // Represent a Card's Rank.
 // Rank is a type that can represent the specific values
@@ -44,7 +47,7 @@ enum Rank {
 
 //REQUIRES str represents a valid rank ("Two", "Three", ..., "Ace")
 //EFFECTS returns the Rank corresponding to str, for example "Two" -> TWO
-Rank string_to_rank(const std::string &str);
+Rank string_to_rank(std::string_view str);
 
 //EFFECTS Prints Rank to stream, for example "Two"
 std::ostream & operator<<(std::ostream &os, Rank rank);
@@ -53,6 +56,10 @@ std::ostream & operator<<(std::ostream &os, Rank rank);
 //EFFECTS Reads a Rank from a stream, for example "Two" -> TWO
 std::istream & operator>>(std::istream &is, Rank &rank);
 
+//EFFECTS If str is the name of a rank, sets rank to it and returns true.
+//  Otherwise returns false and leaves rank unchanged.
+bool parse_rank(std::string_view str, Rank &rank);
+
 // Represent a Card's suit
 enum Suit {
   SPADES   = 0,
@@ -63,7 +70,7 @@ enum Suit {
 
 //REQUIRES str represents a valid suit ("Spades", "Hearts", "Clubs", or "Diamonds")
 //EFFECTS returns the Suit corresponding to str, for example "Clubs" -> CLUBS
-Suit string_to_suit(const std::string &str);
+Suit string_to_suit(std::string_view str);
 
 //EFFECTS Prints Suit to stream, for example "Spades"
 std::ostream & operator<<(std::ostream &os, Suit suit);
@@ -72,21 +79,25 @@ std::ostream & operator<<(std::ostream &os, Suit suit);
 //EFFECTS Reads a Suit from a stream, for example "Spades" -> SPADES
 std::istream & operator>>(std::istream &is, Suit &suit);
 
+//EFFECTS If str is the name of a suit, sets suit to it and returns true.
+//  Otherwise returns false and leaves suit unchanged.
+bool parse_suit(std::string_view str, Suit &suit);
+
 
 class Card {
 public:
 
   //EFFECTS Initializes Card to the Two of Spades
-  Card();
+  constexpr Card() : rank(TWO), suit(SPADES) {}
 
   //EFFECTS Initializes Card to specified rank and suit
-  Card(Rank rank_in, Suit suit_in);
+  constexpr Card(Rank rank_in, Suit suit_in) : rank(rank_in), suit(suit_in) {}
 
   //EFFECTS Returns the rank
-  Rank get_rank() const;
+  constexpr Rank get_rank() const { return rank; }
 
   //EFFECTS Returns the suit.  Does not consider trump.
-  Suit get_suit() const;
+  constexpr Suit get_suit() const { return suit; }
 
   //EFFECTS Returns the suit
   //HINT: the left bower is the trump suit!
@@ -122,6 +133,32 @@ std::ostream & operator<<(std::ostream &os, const Card &card);
 //     which means it is allowed to access card.rank and card.suit.
 std::istream & operator>>(std::istream &is, Card &card);
 
+//EFFECTS Skips leading whitespace, then reads one card in the format
+//  "Two of Spades" from the front of text.  On success, sets card, drops
+//  what was read from the front of text and returns true.  Otherwise
+//  returns false and leaves text and card unchanged.
+bool parse_card(std::string_view &text, Card &card);
+
+//EFFECTS Reads cards in the format "Two of Spades", separated by
+//  whitespace, from text into out.  Stops at the end of text, after
+//  max_cards cards, or at the first thing that is not a card.  Returns
+//  the number of cards read.  Never allocates.
+std::size_t parse_cards(std::string_view text, Card *out,
+                        std::size_t max_cards);
+
+//EFFECTS Returns the cards read from text as by the overload above
+std::vector<Card> parse_cards(std::string_view text);
+
+//EFFECTS Returns the name of rank, for example "Two"
+std::string_view Rank_name(Rank rank);
+
+//EFFECTS Returns the name of suit, for example "Spades"
+std::string_view Suit_name(Suit suit);
+
+//EFFECTS Returns the name of card, for example "Two of Spades".  Names
+//  come from a table built at compile time, so this never allocates.
+std::string_view Card_name(const Card &card);
+
 //EFFECTS Returns true if lhs is lower value than rhs.
 //  Does not consider trump.
 bool operator<(const Card &lhs, const Card &rhs);
@@ -157,4 +194,96 @@ bool Card_less(const Card &a, const Card &b, Suit trump);
 //  and the suit led to determine order, as described in the spec.
 bool Card_less(const Card &a, const Card &b, const Card &led_card, Suit trump);
 
+// Packed card ids.  A Card takes two ints; an id fits in one byte, so
+// packs, hands, tricks and logs can be stored as arrays of CardId.
+//   Card_id numbers all 52 cards 0..51 as rank * 4 + suit.  This is the
+//     order of operator< and the bit numbering used by CardSet.
+//   Card_euchre_id numbers the 24 euchre cards (Nine and up) 0..23 as
+//     (rank - NINE) * 4 + suit, which fits in 5 bits.
+typedef unsigned char CardId;
+
+const int NUM_CARDS = 52;
+const int NUM_EUCHRE_CARDS = 24;
+
+//EFFECTS Returns the id of c, 0..51
+constexpr CardId Card_id(const Card &c) {
+  return static_cast<CardId>(c.get_rank() * 4 + c.get_suit());
+}
+
+//REQUIRES id < NUM_CARDS
+//EFFECTS Returns the card with the given id
+constexpr Card Card_from_id(CardId id) {
+  return Card(static_cast<Rank>(id >> 2), static_cast<Suit>(id & 3));
+}
+
+//REQUIRES c is Nine or higher
+//EFFECTS Returns the euchre id of c, 0..23
+constexpr CardId Card_euchre_id(const Card &c) {
+  return static_cast<CardId>((c.get_rank() - NINE) * 4 + c.get_suit());
+}
+
+//REQUIRES id < NUM_EUCHRE_CARDS
+//EFFECTS Returns the card with the given euchre id
+constexpr Card Card_from_euchre_id(CardId id) {
+  return Card(static_cast<Rank>(NINE + (id >> 2)), static_cast<Suit>(id & 3));
+}
+
+// Trump-aware card ordering tables.  CARD_ORDER.value[trump][led][rank][suit]
+// is the strength of a card when trump is trump and led is the suit led
+// (with the left bower counted as trump), or NO_LED_SUIT when only trump
+// matters.  Strengths are distinct for distinct cards, so for any trump
+// and led suit, comparing two cards is comparing their table entries:
+//   Card_less(a, b, trump)       <=> order(a, NO_LED_SUIT) < order(b, NO_LED_SUIT)
+//   Card_less(a, b, led, trump)  <=> order(a, led) < order(b, led)
+// The tables are built at compile time.
+const int NO_LED_SUIT = 4;
+
+struct CardOrderTable {
+  unsigned char value[4][5][13][4]; // [trump][led suit or NO_LED_SUIT][rank][suit]
+};
+
+//EFFECTS Returns the ordering tables described above
+constexpr CardOrderTable make_card_order_table() {
+  CardOrderTable table = {};
+  for (int trump = SPADES; trump <= DIAMONDS; ++trump) {
+    const int next = trump ^ 2; // the suit of the same color
+    for (int led = SPADES; led <= NO_LED_SUIT; ++led) {
+      // plain cards rank by rank then suit, led cards above them, trump
+      // above those and the bowers on top
+      const int led_base = 52;
+      const int trump_base = (led == NO_LED_SUIT) ? 52 : 65;
+      for (int rank = TWO; rank <= ACE; ++rank) {
+        for (int suit = SPADES; suit <= DIAMONDS; ++suit) {
+          int value = rank * 4 + suit;
+          if (rank == JACK && suit == trump) {
+            value = trump_base + 14;
+          } else if (rank == JACK && suit == next) {
+            value = trump_base + 13;
+          } else if (suit == trump) {
+            value = trump_base + rank;
+          } else if (suit == led) {
+            value = led_base + rank;
+          }
+          table.value[trump][led][rank][suit] =
+            static_cast<unsigned char>(value);
+        }
+      }
+    }
+  }
+  return table;
+}
+
+inline constexpr CardOrderTable CARD_ORDER = make_card_order_table();
+
+//EFFECTS Returns the strength of c for Card_less(a, b, trump)
+inline int Card_order(const Card &c, Suit trump) {
+  return CARD_ORDER.value[trump][NO_LED_SUIT][c.get_rank()][c.get_suit()];
+}
+
+//EFFECTS Returns the strength of c for Card_less(a, b, led_card, trump),
+//  where led_suit is led_card.get_suit(trump)
+inline int Card_order(const Card &c, Suit led_suit, Suit trump) {
+  return CARD_ORDER.value[trump][led_suit][c.get_rank()][c.get_suit()];
+}
+
 #endif // CARD_HPP
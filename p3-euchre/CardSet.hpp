@@ -0,0 +1,213 @@
+#ifndef CARDSET_HPP
+#define CARDSET_HPP
+/* CardSet.hpp
+ *
+ * A set of cards stored as a 64-bit mask.  Each of the 52 cards has one
+ * bit, numbered by Card_id (rank * 4 + suit), so bit order is the same as
+ * Card's operator<.  Queries that respect trump are a few mask operations plus a
+ * popcount or bit scan, with no heap allocation.
+ */
+
+
+#include "Card.hpp"
+#include <cstdint>
+
+class CardSet {
+public:
+  //EFFECTS Initializes an empty set
+  CardSet() : bits(0) {}
+
+  //EFFECTS Initializes a set from a raw mask
+  explicit CardSet(std::uint64_t bits_in) : bits(bits_in) {}
+
+  //EFFECTS Returns the raw mask
+  std::uint64_t mask() const { return bits; }
+
+  //EFFECTS Returns the number of cards in the set
+  int size() const { return popcount(bits); }
+
+  //EFFECTS Returns true if the set has no cards
+  bool empty() const { return bits == 0; }
+
+  //EFFECTS Returns true if c is in the set
+  bool contains(const Card &c) const { return (bits & bit(c)) != 0; }
+
+  //EFFECTS Adds c to the set
+  void add(const Card &c) { bits |= bit(c); }
+
+  //REQUIRES c is in the set
+  //EFFECTS Removes c from the set
+  void remove(const Card &c) { bits &= ~bit(c); }
+
+  //EFFECTS Returns the cards in both sets
+  CardSet operator&(CardSet other) const { return CardSet(bits & other.bits); }
+
+  //EFFECTS Returns the cards in either set
+  CardSet operator|(CardSet other) const { return CardSet(bits | other.bits); }
+
+  //EFFECTS Returns the cards of this set that are not in other
+  CardSet without(CardSet other) const { return CardSet(bits & ~other.bits); }
+
+  //REQUIRES set is not empty
+  //EFFECTS Returns the highest card by operator<, ignoring trump
+  Card highest() const { return card_at(63 - count_leading_zeros(bits)); }
+
+  //REQUIRES set is not empty
+  //EFFECTS Returns the lowest card by operator<, ignoring trump
+  Card lowest() const { return card_at(count_trailing_zeros(bits)); }
+
+  //REQUIRES set is not empty
+  //EFFECTS Returns the highest card under Card_less(a, b, trump)
+  Card highest(Suit trump) const {
+    CardSet trumps = *this & trump_cards(trump);
+    if (trumps.empty()) {
+      return highest();
+    }
+    return trumps.highest_trump(trump);
+  }
+
+  //REQUIRES set is not empty
+  //EFFECTS Returns the lowest card under Card_less(a, b, trump)
+  Card lowest(Suit trump) const {
+    CardSet others = without(trump_cards(trump));
+    if (!others.empty()) {
+      return others.lowest();
+    }
+    return lowest_trump(trump);
+  }
+
+  //REQUIRES set is not empty
+  //EFFECTS Returns the highest card under Card_less(a, b, led_card, trump)
+  Card highest(Suit led_suit, Suit trump) const {
+    CardSet followers = *this & suit_cards(led_suit, trump);
+    if (!(*this & trump_cards(trump)).empty() || followers.empty()) {
+      return highest(trump);
+    }
+    return followers.highest();
+  }
+
+  //REQUIRES set is not empty
+  //EFFECTS Returns the lowest card under Card_less(a, b, led_card, trump)
+  Card lowest(Suit led_suit, Suit trump) const {
+    CardSet others = without(suit_cards(led_suit, trump) | trump_cards(trump));
+    if (!others.empty()) {
+      return others.lowest();
+    }
+    CardSet followers = without(trump_cards(trump));
+    if (!followers.empty()) {
+      return followers.lowest();
+    }
+    return lowest_trump(trump);
+  }
+
+  //EFFECTS Returns every card of suit, treating the left bower as trump
+  static CardSet suit_cards(Suit suit, Suit trump) {
+    if (suit == trump) {
+      return trump_cards(trump);
+    }
+    return CardSet(SUIT_MASK << suit).without(left_bower(trump));
+  }
+
+  //EFFECTS Returns every trump card, including the left bower
+  static CardSet trump_cards(Suit trump) {
+    return CardSet(SUIT_MASK << trump) | left_bower(trump);
+  }
+
+  //EFFECTS Returns every Jack, Queen, King and Ace
+  static CardSet face_or_ace_cards() {
+    return CardSet(FACE_MASK);
+  }
+
+  //EFFECTS Returns the single bit for c
+  static std::uint64_t bit(const Card &c) {
+    return std::uint64_t(1) << Card_id(c);
+  }
+
+  //REQUIRES 0 <= index < 52
+  //EFFECTS Returns the card with bit number index
+  static Card card_at(int index) {
+    return Card_from_id(static_cast<CardId>(index));
+  }
+
+  //EFFECTS Returns the number of set bits in x
+  static int popcount(std::uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(x);
+#else
+    int count = 0;
+    for (; x != 0; x &= x - 1) {
+      ++count;
+    }
+    return count;
+#endif
+  }
+
+  //REQUIRES x != 0
+  //EFFECTS Returns the number of zero bits above the highest set bit
+  static int count_leading_zeros(std::uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_clzll(x);
+#else
+    int n = 0;
+    for (std::uint64_t b = std::uint64_t(1) << 63; (x & b) == 0; b >>= 1) {
+      ++n;
+    }
+    return n;
+#endif
+  }
+
+  //REQUIRES x != 0
+  //EFFECTS Returns the number of zero bits below the lowest set bit
+  static int count_trailing_zeros(std::uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int n = 0;
+    for (; (x & 1) == 0; x >>= 1) {
+      ++n;
+    }
+    return n;
+#endif
+  }
+
+private:
+  // one bit for each rank of suit 0
+  static constexpr std::uint64_t SUIT_MASK = 0x1111111111111ULL;
+  // every card of rank JACK or higher
+  static constexpr std::uint64_t FACE_MASK = 0xFFFFULL << (JACK * 4);
+
+  std::uint64_t bits;
+
+  static CardSet left_bower(Suit trump) {
+    return CardSet(bit(Card(JACK, Suit_next(trump))));
+  }
+
+  // REQUIRES set holds only trump cards and is not empty
+  Card highest_trump(Suit trump) const {
+    Card right(JACK, trump);
+    Card left(JACK, Suit_next(trump));
+    if (contains(right)) {
+      return right;
+    }
+    if (contains(left)) {
+      return left;
+    }
+    return highest();
+  }
+
+  // REQUIRES set is not empty
+  Card lowest_trump(Suit trump) const {
+    Card right(JACK, trump);
+    Card left(JACK, Suit_next(trump));
+    CardSet plain = without(CardSet(bit(right) | bit(left)));
+    if (!plain.empty()) {
+      return plain.lowest();
+    }
+    if (contains(left)) {
+      return left;
+    }
+    return right;
+  }
+};
+
+#endif // CARDSET_HPP
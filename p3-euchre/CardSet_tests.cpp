@@ -0,0 +1,105 @@
+#include "CardSet.hpp"
+#include "Card.hpp"
+#include "unit_test_framework.hpp"
+
+#include <vector>
+
+using namespace std;
+
+// Every euchre card, Nine through Ace of each suit
+static vector<Card> euchre_cards() {
+    vector<Card> cards;
+    for (int s = SPADES; s <= DIAMONDS; ++s) {
+        for (int r = NINE; r <= ACE; ++r) {
+            cards.push_back(Card(static_cast<Rank>(r), static_cast<Suit>(s)));
+        }
+    }
+    return cards;
+}
+
+// Builds the hand with the cards whose positions are set in pick
+static CardSet hand_from(const vector<Card> &cards, unsigned pick) {
+    CardSet hand;
+    for (size_t i = 0; i < cards.size(); ++i) {
+        if (pick & (1u << i)) {
+            hand.add(cards[i]);
+        }
+    }
+    return hand;
+}
+
+TEST(test_cardset_add_remove) {
+    CardSet hand;
+    ASSERT_TRUE(hand.empty());
+    hand.add(Card(ACE, SPADES));
+    hand.add(Card(NINE, HEARTS));
+    hand.add(Card(TWO, CLUBS));
+    ASSERT_EQUAL(hand.size(), 3);
+    ASSERT_TRUE(hand.contains(Card(NINE, HEARTS)));
+    hand.remove(Card(NINE, HEARTS));
+    ASSERT_FALSE(hand.contains(Card(NINE, HEARTS)));
+    ASSERT_EQUAL(hand.highest(), Card(ACE, SPADES));
+    ASSERT_EQUAL(hand.lowest(), Card(TWO, CLUBS));
+}
+
+TEST(test_cardset_suit_cards) {
+    CardSet hearts = CardSet::suit_cards(HEARTS, HEARTS);
+    ASSERT_EQUAL(hearts.size(), 14);
+    ASSERT_TRUE(hearts.contains(Card(JACK, DIAMONDS)));
+    CardSet diamonds = CardSet::suit_cards(DIAMONDS, HEARTS);
+    ASSERT_EQUAL(diamonds.size(), 12);
+    ASSERT_FALSE(diamonds.contains(Card(JACK, DIAMONDS)));
+    ASSERT_EQUAL(CardSet::suit_cards(SPADES, HEARTS).size(), 13);
+}
+
+TEST(test_cardset_bowers) {
+    CardSet hand;
+    hand.add(Card(ACE, CLUBS));
+    hand.add(Card(JACK, SPADES));
+    hand.add(Card(NINE, DIAMONDS));
+    ASSERT_EQUAL(hand.highest(CLUBS), Card(JACK, SPADES));
+    ASSERT_EQUAL(hand.lowest(CLUBS), Card(NINE, DIAMONDS));
+    hand.add(Card(JACK, CLUBS));
+    ASSERT_EQUAL(hand.highest(CLUBS), Card(JACK, CLUBS));
+}
+
+// Trump-aware queries agree with Card_less on sampled five-card hands
+TEST(test_cardset_matches_card_less) {
+    vector<Card> cards = euchre_cards();
+    unsigned pick = 0x1F;
+    for (int n = 0; n < 2000; ++n) {
+        // next set of 24 bits with five bits set (Gosper's hack), stepping
+        // a few at a time to cover varied hands
+        for (int step = 0; step < 17; ++step) {
+            unsigned low = pick & -pick;
+            unsigned ripple = pick + low;
+            pick = (((ripple ^ pick) >> 2) / low) | ripple;
+            if (pick >= (1u << 24)) {
+                pick = 0x1F;
+            }
+        }
+        CardSet hand = hand_from(cards, pick);
+        for (int t = SPADES; t <= DIAMONDS; ++t) {
+            Suit trump = static_cast<Suit>(t);
+            Card hi = hand.highest(trump);
+            Card lo = hand.lowest(trump);
+            for (int l = SPADES; l <= DIAMONDS; ++l) {
+                Suit led = static_cast<Suit>(l);
+                Card led_card(l == t ? JACK : NINE, led);
+                Card led_hi = hand.highest(led, trump);
+                Card led_lo = hand.lowest(led, trump);
+                for (const Card &c : cards) {
+                    if (!hand.contains(c)) {
+                        continue;
+                    }
+                    ASSERT_FALSE(Card_less(hi, c, trump));
+                    ASSERT_FALSE(Card_less(c, lo, trump));
+                    ASSERT_FALSE(Card_less(led_hi, c, led_card, trump));
+                    ASSERT_FALSE(Card_less(c, led_lo, led_card, trump));
+                }
+            }
+        }
+    }
+}
+
+TEST_MAIN()
@@ -1,6 +1,8 @@
 #include "Card.hpp"
 #include "unit_test_framework.hpp"
 #include <iostream>
+#include <sstream>
+#include <string>
 
 using namespace std;
 
@@ -288,6 +290,146 @@ TEST(test_card_get_suit_edge_cases) {
     ASSERT_EQUAL(normal_card.get_suit(SPADES), HEARTS); // Should return normal suit
 }
 
+// Test the trump-aware ordering table: Hearts trump, Clubs led
+TEST(test_card_order_table) {
+    Card right(JACK, HEARTS);
+    Card left(JACK, DIAMONDS);
+    Card ace_trump(ACE, HEARTS);
+    Card nine_trump(NINE, HEARTS);
+    Card ace_led(ACE, CLUBS);
+    Card nine_led(NINE, CLUBS);
+    Card ace_other(ACE, SPADES);
+    Card order[] = {ace_other, nine_led, ace_led, nine_trump, ace_trump,
+                    left, right};
+    for (int i = 0; i + 1 < 7; ++i) {
+        ASSERT_TRUE(Card_order(order[i], CLUBS, HEARTS) <
+                    Card_order(order[i + 1], CLUBS, HEARTS));
+    }
+    // without a led suit the Ace of Clubs is just another plain card
+    ASSERT_TRUE(Card_order(nine_led, HEARTS) < Card_order(ace_other, HEARTS));
+    ASSERT_TRUE(Card_order(ace_led, HEARTS) < Card_order(nine_trump, HEARTS));
+}
+
+// The tables are available at compile time
+TEST(test_card_order_constexpr) {
+    static_assert(CARD_ORDER.value[SPADES][NO_LED_SUIT][JACK][SPADES] >
+                  CARD_ORDER.value[SPADES][NO_LED_SUIT][JACK][CLUBS],
+                  "right bower beats left bower");
+    static_assert(CARD_ORDER.value[SPADES][HEARTS][NINE][HEARTS] >
+                  CARD_ORDER.value[SPADES][HEARTS][ACE][DIAMONDS],
+                  "led suit beats plain cards");
+    ASSERT_TRUE(true);
+}
+
+// Every card survives a round trip through its packed ids
+TEST(test_card_id_round_trip) {
+    for (int id = 0; id < NUM_CARDS; ++id) {
+        Card c = Card_from_id(static_cast<CardId>(id));
+        ASSERT_EQUAL(Card_id(c), id);
+        if (id > 0) {
+            ASSERT_TRUE(Card_from_id(static_cast<CardId>(id - 1)) < c);
+        }
+    }
+    for (int id = 0; id < NUM_EUCHRE_CARDS; ++id) {
+        Card c = Card_from_euchre_id(static_cast<CardId>(id));
+        ASSERT_TRUE(c.get_rank() >= NINE);
+        ASSERT_EQUAL(Card_euchre_id(c), id);
+    }
+}
+
+TEST(test_card_id_constexpr) {
+    static_assert(Card_id(Card(TWO, SPADES)) == 0, "lowest card");
+    static_assert(Card_id(Card(ACE, DIAMONDS)) == 51, "highest card");
+    static_assert(Card_euchre_id(Card(NINE, SPADES)) == 0, "lowest card");
+    static_assert(Card_euchre_id(Card(ACE, DIAMONDS)) == 23, "fits 5 bits");
+    static_assert(Card_from_euchre_id(9).get_rank() == JACK, "Jack of Hearts");
+    static_assert(sizeof(CardId) == 1, "one byte per card");
+    ASSERT_EQUAL(Card_from_euchre_id(9), Card(JACK, HEARTS));
+}
+
+// Every rank and suit name parses back, and near misses are rejected
+TEST(test_parse_rank_and_suit) {
+    for (int r = TWO; r <= ACE; ++r) {
+        Rank rank = TWO;
+        ASSERT_TRUE(parse_rank(Rank_name(static_cast<Rank>(r)), rank));
+        ASSERT_EQUAL(rank, r);
+        ASSERT_EQUAL(string_to_rank(string(Rank_name(rank))), rank);
+    }
+    for (int s = SPADES; s <= DIAMONDS; ++s) {
+        Suit suit = SPADES;
+        ASSERT_TRUE(parse_suit(Suit_name(static_cast<Suit>(s)), suit));
+        ASSERT_EQUAL(suit, s);
+    }
+    const char *bad[] = {"", "T", "Tw", "two", "Twos", "Tex", "Spades",
+                         "Diamond", "Diamondss", "of"};
+    for (const char *str : bad) {
+        Rank rank = KING;
+        ASSERT_FALSE(parse_rank(str, rank));
+        ASSERT_EQUAL(rank, KING);
+    }
+    Suit suit = HEARTS;
+    ASSERT_FALSE(parse_suit("Ace", suit));
+    ASSERT_FALSE(parse_suit("Club", suit));
+    ASSERT_EQUAL(suit, HEARTS);
+}
+
+// parse_cards reads the same cards as operator>>
+TEST(test_parse_cards) {
+    string text;
+    for (int id = 0; id < NUM_CARDS; ++id) {
+        text += Card_name(Card_from_id(static_cast<CardId>(id)));
+        text += (id % 3 == 0) ? "\n" : "  ";
+    }
+    vector<Card> cards = parse_cards(text);
+    ASSERT_EQUAL(cards.size(), static_cast<size_t>(NUM_CARDS));
+    istringstream iss(text);
+    for (const Card &c : cards) {
+        Card read;
+        ASSERT_TRUE(static_cast<bool>(iss >> read));
+        ASSERT_EQUAL(c, read);
+    }
+    ASSERT_EQUAL(cards[NUM_CARDS - 1], Card(ACE, DIAMONDS));
+
+    Card some[3];
+    ASSERT_EQUAL(parse_cards(text, some, 3), static_cast<size_t>(3));
+    ASSERT_EQUAL(some[2], Card(TWO, CLUBS));
+}
+
+// Parsing stops at anything that is not a card and leaves it unread
+TEST(test_parse_card_stops) {
+    string_view text = " Nine of Spades Ten of Hearts\nTen in Hearts";
+    Card card;
+    ASSERT_TRUE(parse_card(text, card));
+    ASSERT_EQUAL(card, Card(NINE, SPADES));
+    ASSERT_TRUE(parse_card(text, card));
+    ASSERT_EQUAL(card, Card(TEN, HEARTS));
+    ASSERT_FALSE(parse_card(text, card));
+    ASSERT_EQUAL(text, "\nTen in Hearts");
+    ASSERT_EQUAL(card, Card(TEN, HEARTS));
+    ASSERT_EQUAL(parse_cards("Jack of Clubs Queen of", nullptr, 0),
+                 static_cast<size_t>(0));
+    ASSERT_EQUAL(parse_cards("Jack of Clubs Queen of").size(),
+                 static_cast<size_t>(1));
+}
+
+// Every pair of euchre cards, compared under each trump suit
+BENCHMARK(bench_card_less_trump) {
+    for (CardId a = 0; a < 24; ++a) {
+        for (CardId b = 0; b < 24; ++b) {
+            const Suit trump = static_cast<Suit>((a + b) % 4);
+            Card_less(Card_from_euchre_id(a), Card_from_euchre_id(b), trump);
+        }
+    }
+}
 
+// Every pair of euchre cards with every led card, spades trump
+BENCHMARK(bench_card_less_led) {
+    for (CardId led = 0; led < 24; ++led) {
+        for (CardId a = 0; a < 24; ++a) {
+            Card_less(Card_from_euchre_id(a), Card_from_euchre_id(23 - a),
+                      Card_from_euchre_id(led), SPADES);
+        }
+    }
+}
 
 TEST_MAIN()
@@ -0,0 +1,183 @@
+#include "Deal.hpp"
+#include <array>
+#include <cassert>
+
+using namespace std;
+
+namespace {
+
+// Card_euchre_id e is Card_id e + EUCHRE_SHIFT, so a set of euchre ids
+// shifted up by it is a CardSet mask
+const int EUCHRE_SHIFT = NINE * 4;
+
+const uint32_t ALL_EUCHRE_IDS = (1u << NUM_EUCHRE_CARDS) - 1;
+
+const int HAND_SIZE = 5;
+
+// BINOMIAL.value[n][k] is C(n, k), for the n and k a deal needs
+struct BinomialTable {
+  uint64_t value[NUM_EUCHRE_CARDS + 1][HAND_SIZE + 1];
+};
+
+constexpr BinomialTable make_binomials() {
+  BinomialTable table = {};
+  for (int n = 0; n <= NUM_EUCHRE_CARDS; ++n) {
+    table.value[n][0] = 1;
+    for (int k = 1; k <= HAND_SIZE && k <= n; ++k) {
+      table.value[n][k] = table.value[n - 1][k - 1] +
+                          (k <= n - 1 ? table.value[n - 1][k] : 0);
+    }
+  }
+  return table;
+}
+
+constexpr BinomialTable BINOMIAL = make_binomials();
+
+// the radix of each digit of a deal index: hands from 24, 19, 14 and 9
+// cards, then the upcard from 4
+constexpr uint64_t RADIX[] = {
+  BINOMIAL.value[24][5], BINOMIAL.value[19][5], BINOMIAL.value[14][5],
+  BINOMIAL.value[9][5], 4
+};
+
+static_assert(RADIX[0] == NUM_HANDS, "NUM_HANDS must match the first digit");
+static_assert(RADIX[0] * RADIX[1] * RADIX[2] * RADIX[3] * RADIX[4] == NUM_DEALS,
+              "NUM_DEALS must match the digits");
+
+// EFFECTS: Returns the euchre id at position pos of the set ids
+int select(uint32_t ids, int pos) {
+  for (; pos > 0; --pos) {
+    ids &= ids - 1;
+  }
+  return CardSet::count_trailing_zeros(ids);
+}
+
+// EFFECTS: Returns the number of ids below id
+int position(uint32_t ids, int id) {
+  return CardSet::popcount(ids & ((1u << id) - 1));
+}
+
+// EFFECTS: Returns the hand of rank among ids, as a set of euchre ids
+uint32_t unrank_hand(uint32_t ids, uint64_t rank) {
+  uint32_t hand = 0;
+  int pos = CardSet::popcount(ids);
+  for (int k = HAND_SIZE; k >= 1; --k) {
+    // largest position whose binomial fits in what is left of rank
+    do {
+      --pos;
+    } while (BINOMIAL.value[pos][k] > rank);
+    rank -= BINOMIAL.value[pos][k];
+    hand |= 1u << select(ids, pos);
+  }
+  return hand;
+}
+
+// EFFECTS: Returns the rank of hand among ids
+uint32_t rank_hand(uint32_t ids, uint32_t hand) {
+  assert(CardSet::popcount(hand) == HAND_SIZE && (hand & ~ids) == 0);
+  uint64_t rank = 0;
+  int k = 1;
+  for (uint32_t m = hand; m != 0; m &= m - 1, ++k) {
+    rank += BINOMIAL.value[position(ids, CardSet::count_trailing_zeros(m))][k];
+  }
+  return static_cast<uint32_t>(rank);
+}
+
+CardSet to_card_set(uint32_t ids) {
+  return CardSet(static_cast<uint64_t>(ids) << EUCHRE_SHIFT);
+}
+
+uint32_t to_euchre_ids(CardSet cards) {
+  return static_cast<uint32_t>(cards.mask() >> EUCHRE_SHIFT) & ALL_EUCHRE_IDS;
+}
+
+} // namespace
+
+uint32_t Deal_hand_rank(CardSet hand) {
+  return rank_hand(ALL_EUCHRE_IDS, to_euchre_ids(hand));
+}
+
+CardSet Deal_hand_unrank(uint32_t rank) {
+  assert(rank < NUM_HANDS);
+  return to_card_set(unrank_hand(ALL_EUCHRE_IDS, rank));
+}
+
+uint64_t Deal_rank(const Deal &deal) {
+  uint32_t ids = ALL_EUCHRE_IDS;
+  uint64_t index = 0;
+  for (int player = 0; player < 4; ++player) {
+    const uint32_t hand = to_euchre_ids(deal.hands[player]);
+    index = index * RADIX[player] + rank_hand(ids, hand);
+    ids &= ~hand;
+  }
+  const int upcard = Card_euchre_id(deal.upcard);
+  assert(ids & (1u << upcard));
+  return index * RADIX[4] + position(ids, upcard);
+}
+
+Deal Deal_unrank(uint64_t index) {
+  assert(index < NUM_DEALS);
+  return *DealIterator(index);
+}
+
+Pack Deal_pack(const Deal &deal, int dealer) {
+  assert(0 <= dealer && dealer < 4);
+  array<Card, PackShuffle::SIZE> order;
+  int next = 0;
+  CardSet hands[4] = {deal.hands[0], deal.hands[1], deal.hands[2], deal.hands[3]};
+  // three, two, three, two round the table, then two, three, two, three,
+  // starting left of the dealer, as BasicEuchreGame deals
+  for (int round = 0; round < 2; ++round) {
+    for (int i = 1; i <= 4; ++i) {
+      CardSet &hand = hands[(dealer + i) % 4];
+      const int n = ((i % 2 == 1) == (round == 0)) ? 3 : 2;
+      for (int k = 0; k < n; ++k) {
+        order[next++] = hand.lowest();
+        hand.remove(order[next - 1]);
+      }
+    }
+  }
+  order[next++] = deal.upcard;
+  CardSet rest = to_card_set(ALL_EUCHRE_IDS).without(
+    deal.hands[0] | deal.hands[1] | deal.hands[2] | deal.hands[3]);
+  rest.remove(deal.upcard);
+  for (; next < PackShuffle::SIZE; ++next) {
+    order[next] = rest.lowest();
+    rest.remove(order[next]);
+  }
+  return Pack(order);
+}
+
+DealIterator::DealIterator(uint64_t index) : current(index) {
+  assert(index <= NUM_DEALS);
+  uint64_t rest = index % NUM_DEALS;
+  for (int d = DIGITS - 1; d >= 0; --d) {
+    digits[d] = static_cast<int>(rest % RADIX[d]);
+    rest /= RADIX[d];
+  }
+  left[0] = ALL_EUCHRE_IDS;
+  fill_from(0);
+}
+
+DealIterator & DealIterator::operator++() {
+  assert(current < NUM_DEALS);
+  ++current;
+  int d = DIGITS - 1;
+  while (d > 0 && digits[d] + 1 == static_cast<int>(RADIX[d])) {
+    digits[d--] = 0;
+  }
+  // past the last deal every digit wraps round to zero
+  digits[d] = (digits[d] + 1) % static_cast<int>(RADIX[d]);
+  fill_from(d);
+  return *this;
+}
+
+void DealIterator::fill_from(int first) {
+  for (int d = first; d < DIGITS - 1; ++d) {
+    const uint32_t hand = unrank_hand(left[d], digits[d]);
+    deal.hands[d] = to_card_set(hand);
+    left[d + 1] = left[d] & ~hand;
+  }
+  deal.upcard = Card_from_euchre_id(
+    static_cast<CardId>(select(left[DIGITS - 1], digits[DIGITS - 1])));
+}
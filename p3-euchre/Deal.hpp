@@ -0,0 +1,140 @@
+#ifndef DEAL_HPP
+#define DEAL_HPP
+/* Deal.hpp
+ *
+ * Every deal of the euchre pack, numbered.  A deal gives five cards to
+ * each player and turns up the upcard; the other three cards stay face
+ * down.  There are NUM_DEALS deals, counting which player gets which
+ * hand, and each has an index that fits in 64 bits:
+ *
+ *   index = (((h0 * C(19,5) + h1) * C(14,5) + h2) * C(9,5) + h3) * 4 + u
+ *
+ * where h0 is the rank of player 0's hand among the 24 cards, h1 the rank
+ * of player 1's hand among the 19 left, and so on, and u is the position
+ * of the upcard among the last 4.  A hand's rank is its number in the
+ * combinatorial number system: with the hand's cards at positions
+ * p1 < ... < p5 of the cards left (in Card_euchre_id order), its rank is
+ * C(p1,1) + C(p2,2) + ... + C(p5,5).
+ *
+ * DealIterator walks deals in index order, and Deal_for_each spreads an
+ * index range over threads, so a rule can be evaluated over every deal
+ * rather than a sample.
+ */
+
+
+#include "Card.hpp"
+#include "CardSet.hpp"
+#include "Pack.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+struct Deal {
+  CardSet hands[4];  // indexed by player
+  Card upcard;
+};
+
+// number of deals: C(24,5) * C(19,5) * C(14,5) * C(9,5) * 4
+constexpr std::uint64_t NUM_DEALS = 42504ULL * 11628 * 2002 * 126 * 4;
+
+// number of five-card hands from the euchre pack: C(24,5)
+constexpr std::uint32_t NUM_HANDS = 42504;
+
+//REQUIRES hand holds five euchre cards
+//EFFECTS Returns the rank of hand among all five-card hands, less than
+//  NUM_HANDS; this is player 0's digit of a deal index
+std::uint32_t Deal_hand_rank(CardSet hand);
+
+//REQUIRES rank < NUM_HANDS
+//EFFECTS Returns the hand with the given rank
+CardSet Deal_hand_unrank(std::uint32_t rank);
+
+//REQUIRES the hands hold five euchre cards each, and they and the upcard
+//  are all different
+//EFFECTS Returns the index of deal, less than NUM_DEALS
+std::uint64_t Deal_rank(const Deal &deal);
+
+//REQUIRES index < NUM_DEALS
+//EFFECTS Returns the deal with the given index
+Deal Deal_unrank(std::uint64_t index);
+
+//REQUIRES deal is as for Deal_rank, and 0 <= dealer < 4
+//EFFECTS Returns a pack that BasicEuchreGame deals as deal when dealer
+//  deals and the pack is not shuffled
+Pack Deal_pack(const Deal &deal, int dealer);
+
+// Steps through deals in index order.  Moving to the next deal only
+// redoes the hands whose rank changed, which is usually just the upcard.
+class DealIterator {
+public:
+  //REQUIRES index <= NUM_DEALS
+  //EFFECTS Initializes an iterator at the deal with the given index
+  explicit DealIterator(std::uint64_t index);
+
+  //EFFECTS Returns the index of the current deal
+  std::uint64_t index() const { return current; }
+
+  //REQUIRES index() < NUM_DEALS
+  //EFFECTS Returns the current deal
+  const Deal & operator*() const { return deal; }
+  const Deal * operator->() const { return &deal; }
+
+  //REQUIRES index() < NUM_DEALS
+  //EFFECTS Moves to the next deal
+  DealIterator & operator++();
+
+private:
+  static const int DIGITS = 5;  // four hands, then the upcard
+
+  std::uint64_t current;
+  int digits[DIGITS];           // the mixed-radix digits of current
+  std::uint32_t left[DIGITS];   // euchre ids not yet dealt before digit
+  Deal deal;
+
+  // EFFECTS: Sets the hands and upcard from digits[first] on
+  void fill_from(int first);
+};
+
+//REQUIRES begin <= end <= NUM_DEALS; visit can be called from several
+//  threads at once with different worker numbers
+//EFFECTS Calls visit(worker, index, deal) once for every deal with index
+//  in [begin, end), spread over threads worker threads (0 means one per
+//  hardware thread).  worker is 0 .. threads - 1 and each worker is only
+//  ever on one thread, so visit can keep per-worker totals without locks.
+//  Each worker takes runs of consecutive indices and visits them in
+//  order.
+template <class Visit>
+void Deal_for_each(std::uint64_t begin, std::uint64_t end, int threads,
+                   Visit visit) {
+  // deals a worker claims at a time
+  const std::uint64_t chunk = 4096;
+  if (threads <= 0) {
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  }
+  std::atomic<std::uint64_t> next(begin);
+  auto work = [&](int worker) {
+    while (true) {
+      const std::uint64_t first = next.fetch_add(chunk, std::memory_order_relaxed);
+      if (first >= end) {
+        break;
+      }
+      const std::uint64_t last = std::min(first + chunk, end);
+      for (DealIterator it(first); it.index() < last; ++it) {
+        visit(worker, it.index(), *it);
+      }
+    }
+  };
+  std::vector<std::thread> helpers;
+  for (int t = 1; t < threads; ++t) {
+    helpers.emplace_back(work, t);
+  }
+  // the calling thread works too
+  work(0);
+  for (std::thread &helper : helpers) {
+    helper.join();
+  }
+}
+
+#endif // DEAL_HPP
@@ -0,0 +1,162 @@
+#include "Deal.hpp"
+#include "Card.hpp"
+#include "CardSet.hpp"
+#include "Game.hpp"
+#include "Pack.hpp"
+#include "Random.hpp"
+#include "SimplePlayer.hpp"
+#include "unit_test_framework.hpp"
+
+#include <atomic>
+#include <vector>
+
+using namespace std;
+
+// Plays as a SimplePlayer and records the cards it is dealt and the upcard
+class Recorder : public Player {
+public:
+    Recorder() : inner("Recorder") {}
+
+    const string & get_name() const override { return inner.get_name(); }
+    void add_card(const Card &c) override {
+        dealt.add(c);
+        inner.add_card(c);
+    }
+    bool make_trump(const Card &upcard_in, bool is_dealer, int round,
+                    Suit &order_up_suit) const override {
+        upcard = upcard_in;
+        return inner.make_trump(upcard_in, is_dealer, round, order_up_suit);
+    }
+    void add_and_discard(const Card &c) override { inner.add_and_discard(c); }
+    Card lead_card(Suit trump) override { return inner.lead_card(trump); }
+    Card play_card(const Card &led, Suit trump) override {
+        return inner.play_card(led, trump);
+    }
+
+    CardSet dealt;
+    mutable Card upcard;
+
+private:
+    SimplePlayer inner;
+};
+
+// A deal is five different cards to each player and an upcard
+static void assert_valid(const Deal &deal) {
+    CardSet all;
+    for (const CardSet &hand : deal.hands) {
+        ASSERT_EQUAL(hand.size(), 5);
+        ASSERT_TRUE((all & hand).empty());
+        all = all | hand;
+    }
+    ASSERT_FALSE(all.contains(deal.upcard));
+    ASSERT_TRUE(deal.upcard.get_rank() >= NINE);
+    ASSERT_TRUE(all.lowest().get_rank() >= NINE);
+}
+
+static void assert_same(const Deal &a, const Deal &b) {
+    for (int player = 0; player < 4; ++player) {
+        ASSERT_EQUAL(a.hands[player].mask(), b.hands[player].mask());
+    }
+    ASSERT_EQUAL(a.upcard, b.upcard);
+}
+
+TEST(test_deal_count_and_ends) {
+    // 24! / (5!^4 * 3!): the three cards left face down are in no order
+    ASSERT_EQUAL(NUM_DEALS, 498688594500096ULL);
+    Deal first = Deal_unrank(0);
+    assert_valid(first);
+    ASSERT_EQUAL(first.hands[0].lowest(), Card(NINE, SPADES));
+    ASSERT_EQUAL(Deal_rank(first), 0u);
+    Deal last = Deal_unrank(NUM_DEALS - 1);
+    assert_valid(last);
+    ASSERT_EQUAL(last.hands[0].highest(), Card(ACE, DIAMONDS));
+    ASSERT_EQUAL(Deal_rank(last), NUM_DEALS - 1);
+}
+
+// Ranking undoes unranking, and the other way round for shuffled deals
+TEST(test_deal_rank_round_trip) {
+    Rng rng(16);
+    for (int i = 0; i < 2000; ++i) {
+        uint64_t index = rng.next() % NUM_DEALS;
+        Deal deal = Deal_unrank(index);
+        assert_valid(deal);
+        ASSERT_EQUAL(Deal_rank(deal), index);
+
+        Pack pack;
+        pack.shuffle(rng);
+        Deal shuffled;
+        for (int player = 0; player < 4; ++player) {
+            for (int k = 0; k < 5; ++k) {
+                shuffled.hands[player].add(pack.deal_one());
+            }
+        }
+        shuffled.upcard = pack.deal_one();
+        assert_same(Deal_unrank(Deal_rank(shuffled)), shuffled);
+    }
+}
+
+// A hand's rank is player 0's digit, so hands come in deal order
+TEST(test_deal_hand_rank) {
+    ASSERT_EQUAL(Deal_hand_rank(Deal_unrank(0).hands[0]), 0u);
+    for (uint32_t rank = 0; rank < NUM_HANDS; rank += 11) {
+        const CardSet hand = Deal_hand_unrank(rank);
+        ASSERT_EQUAL(Deal_hand_rank(hand), rank);
+        const uint64_t index = uint64_t(rank) * (NUM_DEALS / NUM_HANDS);
+        ASSERT_EQUAL(Deal_unrank(index).hands[0].mask(), hand.mask());
+    }
+}
+
+// Stepping matches unranking, across every kind of carry and off the end
+TEST(test_deal_iterator) {
+    const uint64_t starts[] = {0, 4 * 126 - 3, 4 * 126 * 2002 - 5,
+                               4ULL * 126 * 2002 * 11628 - 7, NUM_DEALS - 9};
+    for (uint64_t start : starts) {
+        DealIterator it(start);
+        for (int step = 0; step < 9; ++step, ++it) {
+            ASSERT_EQUAL(it.index(), start + step);
+            assert_same(*it, Deal_unrank(start + step));
+        }
+    }
+    DealIterator it(NUM_DEALS - 1);
+    ++it;
+    ASSERT_EQUAL(it.index(), NUM_DEALS);
+}
+
+// Every index in the range is visited once, by one worker
+TEST(test_deal_for_each) {
+    const uint64_t begin = 123456789;
+    const uint64_t end = begin + 50000;
+    vector<uint64_t> count(4), sum(4);
+    atomic<bool> ok(true);
+    auto visit = [&](int worker, uint64_t index, const Deal &deal) {
+        ++count[worker];
+        sum[worker] += index - begin;
+        if (Deal_rank(deal) != index) {
+            ok = false;
+        }
+    };
+    Deal_for_each(begin, end, 4, visit);
+    ASSERT_TRUE(ok);
+    ASSERT_EQUAL(count[0] + count[1] + count[2] + count[3], end - begin);
+    const uint64_t n = end - begin;
+    ASSERT_EQUAL(sum[0] + sum[1] + sum[2] + sum[3], n * (n - 1) / 2);
+}
+
+// The pack for a deal makes the game deal exactly that deal
+TEST(test_deal_pack) {
+    Rng rng(3);
+    for (int i = 0; i < 20; ++i) {
+        Deal deal = Deal_unrank(rng.next() % NUM_DEALS);
+        Recorder seats[4];
+        vector<Player*> players = {&seats[0], &seats[1], &seats[2], &seats[3]};
+        // one point wins, so the game is one hand with player 0 dealing
+        EuchreGame game(Deal_pack(deal, 0), false, 1, players, nullptr);
+        game.startGame();
+        for (int player = 0; player < 4; ++player) {
+            ASSERT_EQUAL(seats[player].dealt.mask(), deal.hands[player].mask());
+        }
+        ASSERT_EQUAL(seats[1].upcard, deal.upcard);
+    }
+}
+
+TEST_MAIN()
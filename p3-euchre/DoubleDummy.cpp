@@ -0,0 +1,345 @@
+#include "DoubleDummy.hpp"
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+namespace {
+
+// most cards in a hand, so most tricks left and most moves at one turn
+const int MAX_TRICKS = 13;
+
+// effective suit of card id when trump is trump (the left bower is trump)
+constexpr int effective_suit(int id, int trump) {
+  return ((id >> 2) == JACK && (id & 3) == (trump ^ 2)) ? trump : (id & 3);
+}
+
+// CARD_ORDER strength of card id, with led NO_LED_SUIT or a suit
+inline int strength(int id, int led, Suit trump) {
+  return CARD_ORDER.value[trump][led][id >> 2][id & 3];
+}
+
+// The cards of each effective suit, for each trump.  Taking the plain
+// cards in id order and then the left and right bowers lists a suit
+// weakest first.
+struct SuitMaskTable {
+  uint64_t all[4][4];   // [trump][suit]
+  uint64_t plain[4][4]; // without the bowers
+};
+
+constexpr SuitMaskTable make_suit_masks() {
+  SuitMaskTable table = {};
+  for (int trump = SPADES; trump <= DIAMONDS; ++trump) {
+    for (int id = 0; id < NUM_CARDS; ++id) {
+      const int suit = effective_suit(id, trump);
+      table.all[trump][suit] |= uint64_t(1) << id;
+      if ((id >> 2) != JACK || suit != trump) {
+        table.plain[trump][suit] |= uint64_t(1) << id;
+      }
+    }
+  }
+  return table;
+}
+
+constexpr SuitMaskTable SUIT_MASKS = make_suit_masks();
+
+inline uint64_t bit(int id) {
+  return uint64_t(1) << id;
+}
+
+// EFFECTS: Returns how promising a card of strength s looks, higher first.
+//   Leads go high; otherwise the cheapest card that takes the trick from
+//   the opponents, then the cheapest card.
+inline int move_score(int s, int pos, bool partner_winning, int winning) {
+  if (pos == 0) {
+    return s;
+  }
+  if (!partner_winning && s > winning) {
+    return 1000 - s;
+  }
+  return -s;
+}
+
+} // namespace
+
+DoubleDummySolver::DoubleDummySolver(int table_bits)
+  : table(size_t(1) << table_bits), table_shift(64 - table_bits),
+    node_count(0), hands{0, 0, 0, 0}, in_trick(0), trump(SPADES) {
+  assert(0 < table_bits && table_bits <= 28);
+}
+
+void DoubleDummySolver::clear() {
+  fill(table.begin(), table.end(), Entry());
+  node_count = 0;
+}
+
+int DoubleDummySolver::solve(const CardSet hands_in[4], Suit trump_in,
+                             int leader, int team) {
+  DoubleDummyPosition position;
+  copy(hands_in, hands_in + 4, position.hands);
+  position.trump = trump_in;
+  position.leader = leader;
+  return solve(position, team);
+}
+
+int DoubleDummySolver::solve(const DoubleDummyPosition &position, int team) {
+  assert(team == 0 || team == 1);
+  const Trick trick = load(position);
+  const int pos = position.played;
+  const int tricks = CardSet::popcount(hands[(trick.leader + pos) % 4]);
+  const int team0 = solve_from(trick, pos, tricks);
+  return (team == 0) ? team0 : tricks - team0;
+}
+
+int DoubleDummySolver::solve_moves(const DoubleDummyPosition &position,
+                                   Card *moves, int *tricks) {
+  const Trick trick = load(position);
+  const int pos = position.played;
+  const int seat = (trick.leader + pos) % 4;
+  const int total = CardSet::popcount(hands[seat]);
+  const uint64_t legal = legal_cards(trick, pos);
+  const uint64_t live = hands[0] | hands[1] | hands[2] | hands[3] | in_trick;
+
+  // search only the highest card of each run of equivalent cards; the
+  // others copy its value
+  int value_of[NUM_CARDS];
+  for (uint64_t m = legal; m != 0; m &= m - 1) {
+    const int id = CardSet::count_trailing_zeros(m);
+    if ((next_live(id, live) & legal) == 0) {
+      hands[seat] &= ~bit(id);
+      in_trick |= bit(id);
+      const int team0 = solve_from(after_play(trick, pos, id), pos + 1, total);
+      hands[seat] |= bit(id);
+      in_trick &= ~bit(id);
+      value_of[id] = (seat % 2 == 0) ? team0 : total - team0;
+    }
+  }
+  int n = 0;
+  for (uint64_t m = legal; m != 0; m &= m - 1) {
+    const int id = CardSet::count_trailing_zeros(m);
+    int top = id;
+    while (uint64_t next = next_live(top, live) & legal) {
+      top = CardSet::count_trailing_zeros(next);
+    }
+    moves[n] = Card_from_id(static_cast<CardId>(id));
+    tricks[n++] = value_of[top];
+  }
+  return n;
+}
+
+DoubleDummySolver::Trick DoubleDummySolver::load(const DoubleDummyPosition &position) {
+  assert(0 <= position.leader && position.leader < 4);
+  assert(0 <= position.played && position.played < 4);
+  for (int seat = 0; seat < 4; ++seat) {
+    hands[seat] = position.hands[seat].mask();
+  }
+  trump = position.trump;
+  in_trick = 0;
+  Trick trick = {position.leader, NO_LED_SUIT, position.leader, -1};
+  for (int pos = 0; pos < position.played; ++pos) {
+    const int id = Card_id(position.trick[pos]);
+    in_trick |= bit(id);
+    trick = after_play(trick, pos, id);
+  }
+  return trick;
+}
+
+DoubleDummySolver::Trick DoubleDummySolver::after_play(const Trick &trick,
+                                                       int pos, int id) const {
+  Trick next = trick;
+  if (pos == 0) {
+    next.led_suit = effective_suit(id, trump);
+  }
+  const int s = strength(id, next.led_suit, trump);
+  if (s > next.strength) {
+    next.winner = (trick.leader + pos) % 4;
+    next.strength = s;
+  }
+  return next;
+}
+
+uint64_t DoubleDummySolver::legal_cards(const Trick &trick, int pos) const {
+  const uint64_t hand = hands[(trick.leader + pos) % 4];
+  if (pos == 0) {
+    return hand;
+  }
+  const uint64_t follow = hand & SUIT_MASKS.all[trump][trick.led_suit];
+  return (follow != 0) ? follow : hand;
+}
+
+int DoubleDummySolver::solve_from(const Trick &trick, int pos, int max_tricks) {
+  // narrow in on the answer with null-window searches, which cut off far
+  // more than one search over the whole range
+  int lower = 0;
+  int upper = max_tricks;
+  while (lower < upper) {
+    const int target = (lower + upper + 1) / 2;
+    const int value = search_play(trick, pos, target - 1, target);
+    if (value >= target) {
+      lower = value;
+    } else {
+      upper = value;
+    }
+  }
+  return lower;
+}
+
+uint64_t DoubleDummySolver::position_hash(int leader) const {
+  uint64_t h = hands[0] * 0x9E3779B97F4A7C15ULL;
+  h ^= hands[1] * 0xC2B2AE3D27D4EB4FULL;
+  h ^= hands[2] * 0x165667B19E3779F9ULL;
+  h ^= hands[3] * 0x27D4EB2F165667C5ULL;
+  h ^= static_cast<uint64_t>(leader * 4 + trump);
+  // finish as in MurmurHash3 so every bit depends on every input bit
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDULL;
+  h ^= h >> 33;
+  return h | 1;
+}
+
+int DoubleDummySolver::search_trick(int leader, int alpha, int beta) {
+  const int left = CardSet::popcount(hands[leader]);
+  if (left == 0 || beta <= 0) {
+    return 0;
+  }
+  if (alpha >= left) {
+    return left;
+  }
+  if (left == 1) {
+    return last_trick(leader);
+  }
+  const uint64_t hash = position_hash(leader);
+  Entry &slot = table[hash >> table_shift];
+  int lower = 0;
+  int upper = left;
+  if (slot.hash == hash) {
+    lower = slot.lower;
+    upper = slot.upper;
+    if (lower >= beta || lower == upper) {
+      return lower;
+    }
+    if (upper <= alpha) {
+      return upper;
+    }
+    alpha = max(alpha, lower);
+    beta = min(beta, upper);
+  }
+
+  Trick trick = {leader, NO_LED_SUIT, leader, -1};
+  int value = search_play(trick, 0, alpha, beta);
+  if (value <= alpha) {
+    upper = value;
+  } else if (value >= beta) {
+    lower = value;
+  } else {
+    lower = upper = value;
+  }
+
+  // deeper positions may have used the slot meanwhile; overwrite them
+  slot.hash = hash;
+  slot.lower = static_cast<int8_t>(lower);
+  slot.upper = static_cast<int8_t>(upper);
+  return value;
+}
+
+int DoubleDummySolver::last_trick(int leader) const {
+  const int led_id = CardSet::count_trailing_zeros(hands[leader]);
+  const int led = effective_suit(led_id, trump);
+  int winner = leader;
+  int best = strength(led_id, led, trump);
+  for (int pos = 1; pos < 4; ++pos) {
+    const int seat = (leader + pos) % 4;
+    const int s = strength(CardSet::count_trailing_zeros(hands[seat]), led, trump);
+    if (s > best) {
+      winner = seat;
+      best = s;
+    }
+  }
+  return (winner % 2 == 0) ? 1 : 0;
+}
+
+int DoubleDummySolver::search_play(const Trick &trick, int pos,
+                                   int alpha, int beta) {
+  if (pos == 4) {
+    const int won = (trick.winner % 2 == 0) ? 1 : 0;
+    const uint64_t played = in_trick;
+    in_trick = 0;
+    int value = won + search_trick(trick.winner, alpha - won, beta - won);
+    in_trick = played;
+    return value;
+  }
+
+  ++node_count;
+  const int seat = (trick.leader + pos) % 4;
+  const bool maximizing = (seat % 2 == 0);
+  CardId moves[MAX_TRICKS];
+  const int n = generate_moves(trick, pos, moves);
+  int best = maximizing ? -1 : MAX_TRICKS + 1;
+  for (int i = 0; i < n && alpha < beta; ++i) {
+    const int id = moves[i];
+    hands[seat] &= ~bit(id);
+    in_trick |= bit(id);
+    int value = search_play(after_play(trick, pos, id), pos + 1, alpha, beta);
+    hands[seat] |= bit(id);
+    in_trick &= ~bit(id);
+
+    if (maximizing) {
+      best = max(best, value);
+      alpha = max(alpha, value);
+    } else {
+      best = min(best, value);
+      beta = min(beta, value);
+    }
+  }
+  return best;
+}
+
+int DoubleDummySolver::generate_moves(const Trick &trick, int pos,
+                                      CardId *moves) const {
+  const int seat = (trick.leader + pos) % 4;
+  const uint64_t legal = legal_cards(trick, pos);
+
+  // Of each run of this player's cards with no other unplayed card between
+  // them, only the highest is a distinct move.  Cards already played to
+  // this trick still count as between.
+  const uint64_t live = hands[0] | hands[1] | hands[2] | hands[3] | in_trick;
+  const int led = (pos == 0) ? NO_LED_SUIT : trick.led_suit;
+  const bool partner_winning = pos > 0 && trick.winner % 2 == seat % 2;
+  int scores[MAX_TRICKS];
+  int n = 0;
+  for (uint64_t m = legal; m != 0; m &= m - 1) {
+    const int id = CardSet::count_trailing_zeros(m);
+    if ((next_live(id, live) & legal) != 0) {
+      continue;
+    }
+    const int score = move_score(strength(id, led, trump), pos,
+                                 partner_winning, trick.strength);
+    int i = n++;
+    for (; i > 0 && scores[i - 1] < score; --i) {
+      moves[i] = moves[i - 1];
+      scores[i] = scores[i - 1];
+    }
+    moves[i] = static_cast<CardId>(id);
+    scores[i] = score;
+  }
+  return n;
+}
+
+uint64_t DoubleDummySolver::next_live(int id, uint64_t live) const {
+  const uint64_t left = bit(JACK * 4 + (trump ^ 2));
+  const uint64_t right = bit(JACK * 4 + trump);
+  const int suit = effective_suit(id, trump);
+  uint64_t above = 0;
+  if (bit(id) == right) {
+    return 0;
+  } else if (bit(id) == left) {
+    above = live & right;
+  } else {
+    // plain cards of a suit are in rank order by id
+    above = live & SUIT_MASKS.plain[trump][suit] & ~((bit(id) << 1) - 1);
+    if (above == 0 && suit == trump) {
+      above = (live & left) ? left : (live & right);
+    }
+  }
+  return above & (0 - above);
+}
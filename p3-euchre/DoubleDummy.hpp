@@ -0,0 +1,138 @@
+#ifndef DOUBLEDUMMY_HPP
+#define DOUBLEDUMMY_HPP
+/* DoubleDummy.hpp
+ *
+ * Double-dummy solver for the play of a euchre hand: with every hand
+ * visible and both teams playing perfectly, how many tricks does a team
+ * take?  This is the position playHand reaches once trump is made.
+ *
+ * The search is alpha-beta over single card plays, with
+ *   - move ordering: cheap winning cards and high leads are tried first,
+ *   - equivalent-card merging: of cards in one hand that are adjacent in
+ *     their suit, with nothing unplayed between them, only one is tried,
+ *   - a transposition table of trick-start positions, keyed on a hash of
+ *     the remaining hands, the leader and trump, holding bounds on the
+ *     number of tricks left.
+ * The table is kept between calls, so solving many deals with one solver
+ * reuses what was learned about shared endings.
+ */
+
+
+#include "Card.hpp"
+#include "CardSet.hpp"
+#include <cstdint>
+#include <vector>
+
+// A position part way through the play of a hand
+struct DoubleDummyPosition {
+  CardSet hands[4];  // cards each player has left
+  Suit trump = SPADES;
+  int leader = 0;    // player who leads, or led, the current trick
+  Card trick[3];     // cards already played to it, by leader, leader + 1, ...
+  int played = 0;    // how many of trick are set, 0..3
+};
+
+class DoubleDummySolver {
+public:
+  //REQUIRES 0 < table_bits <= 28
+  //EFFECTS Initializes a solver with a transposition table of
+  //  2^table_bits entries
+  explicit DoubleDummySolver(int table_bits = 16);
+
+  //REQUIRES hands[0..3] are disjoint and hold the same number of cards,
+  //  at most 13; 0 <= leader < 4; team is 0 or 1
+  //EFFECTS Returns the number of the remaining tricks that team takes
+  //  when leader leads the next trick and everyone plays perfectly.
+  //  Team 0 is players 0 and 2, as in GameResult.
+  int solve(const CardSet hands[4], Suit trump, int leader, int team);
+
+  //REQUIRES the players yet to play to the current trick each hold the
+  //  same number of cards, at most 13, and those who have played hold
+  //  one fewer; team is 0 or 1
+  //EFFECTS Returns the number of the remaining tricks, counting the
+  //  current one, that team takes with perfect play from position
+  int solve(const DoubleDummyPosition &position, int team);
+
+  //REQUIRES position is as for solve, and moves and tricks have room for
+  //  one entry per card in the hand of the player to move
+  //EFFECTS Stores each card the player to move may legally play in
+  //  moves, and in tricks the number of the remaining tricks, counting
+  //  the current one, that the mover's team takes if they play it and
+  //  everyone plays perfectly after.  Returns the number of cards.
+  int solve_moves(const DoubleDummyPosition &position, Card *moves,
+                  int *tricks);
+
+  //EFFECTS Returns the number of card plays searched since construction
+  //  or the last clear()
+  std::uint64_t nodes() const { return node_count; }
+
+  //EFFECTS Empties the transposition table and resets nodes()
+  void clear();
+
+private:
+  struct Entry {
+    std::uint64_t hash;  // position_hash of the position, 0 if unused
+    std::int8_t lower;   // bounds on tricks left for team 0
+    std::int8_t upper;
+  };
+
+  // the trick in progress
+  struct Trick {
+    int leader;
+    int led_suit;
+    int winner;    // seat playing the winning card so far
+    int strength;  // its CARD_ORDER strength for led_suit
+  };
+
+  std::vector<Entry> table;
+  int table_shift;
+  std::uint64_t node_count;
+
+  // position being searched
+  std::uint64_t hands[4];
+  std::uint64_t in_trick;  // cards played to the current trick
+  Suit trump;
+
+  // EFFECTS: Sets up the search for position and returns its trick
+  Trick load(const DoubleDummyPosition &position);
+
+  // EFFECTS: Returns trick after the player at position pos plays card id
+  Trick after_play(const Trick &trick, int pos, int id) const;
+
+  // EFFECTS: Returns the cards the player at position pos may play
+  std::uint64_t legal_cards(const Trick &trick, int pos) const;
+
+  // EFFECTS: Returns the exact number of tricks left for team 0, counting
+  //          trick, with pos cards of it played and at most max_tricks left
+  int solve_from(const Trick &trick, int pos, int max_tricks);
+
+  // EFFECTS: Returns tricks left for team 0, searching from the start of
+  //          a trick led by leader.  The result is exact if it lies
+  //          strictly between alpha and beta, otherwise it is a bound.
+  int search_trick(int leader, int alpha, int beta);
+
+  // EFFECTS: As search_trick, with pos (0..3) cards of trick played.
+  //          Once all four are played, the trick is scored and the next
+  //          one searched.
+  int search_play(const Trick &trick, int pos, int alpha, int beta);
+
+  // EFFECTS: Stores the cards the player at position pos of trick may
+  //          usefully play in moves, best guesses first, and returns how
+  //          many there are
+  int generate_moves(const Trick &trick, int pos, CardId *moves) const;
+
+  // EFFECTS: Returns the bit of the next card above card id in its suit
+  //          that is in live, or 0 if there is none
+  std::uint64_t next_live(int id, std::uint64_t live) const;
+
+  // REQUIRES: every hand holds exactly one card
+  // EFFECTS: Returns 1 if team 0 takes the last trick, led by leader
+  int last_trick(int leader) const;
+
+  // EFFECTS: Returns a nonzero 64-bit hash of the remaining hands, leader
+  //          and trump.  Its top bits pick the table slot and the whole
+  //          hash identifies the position stored there.
+  std::uint64_t position_hash(int leader) const;
+};
+
+#endif // DOUBLEDUMMY_HPP
@@ -0,0 +1,193 @@
+#include "DoubleDummy.hpp"
+#include "CardSet.hpp"
+#include "Card.hpp"
+#include "Pack.hpp"
+#include "Random.hpp"
+#include "unit_test_framework.hpp"
+
+#include <algorithm>
+#include <vector>
+
+using namespace std;
+
+// Plain minimax over every legal card, with no pruning, used to check the
+// solver.  Returns tricks left for team 0.
+static int brute_force(vector<Card> hands[4], Suit trump, int leader,
+                       vector<Card> &trick) {
+    int pos = static_cast<int>(trick.size());
+    if (pos == 4) {
+        int winner = 0;
+        for (int i = 1; i < 4; ++i) {
+            if (Card_less(trick[winner], trick[i], trick[0], trump)) {
+                winner = i;
+            }
+        }
+        int seat = (leader + winner) % 4;
+        vector<Card> next;
+        return (seat % 2 == 0) + brute_force(hands, trump, seat, next);
+    }
+    int seat = (leader + pos) % 4;
+    vector<Card> &hand = hands[seat];
+    if (hand.empty()) {
+        return 0;
+    }
+    bool can_follow = pos > 0 && any_of(hand.begin(), hand.end(), [&](const Card &c) {
+        return c.get_suit(trump) == trick[0].get_suit(trump);
+    });
+    int best = (seat % 2 == 0) ? -1 : 99;
+    for (size_t i = 0; i < hand.size(); ++i) {
+        Card c = hand[i];
+        if (can_follow && c.get_suit(trump) != trick[0].get_suit(trump)) {
+            continue;
+        }
+        hand.erase(hand.begin() + i);
+        trick.push_back(c);
+        int value = brute_force(hands, trump, leader, trick);
+        trick.pop_back();
+        hand.insert(hand.begin() + i, c);
+        best = (seat % 2 == 0) ? max(best, value) : min(best, value);
+    }
+    return best;
+}
+
+// Deals n cards to each player from a randomly shuffled euchre pack
+static void deal(Rng &rng, int n, vector<Card> hands[4], CardSet sets[4]) {
+    Pack pack;
+    pack.shuffle(rng);
+    for (int seat = 0; seat < 4; ++seat) {
+        hands[seat].clear();
+        sets[seat] = CardSet();
+        for (int i = 0; i < n; ++i) {
+            Card c = pack.deal_one();
+            hands[seat].push_back(c);
+            sets[seat].add(c);
+        }
+    }
+}
+
+TEST(test_dd_single_trick) {
+    CardSet hands[4];
+    hands[0].add(Card(NINE, HEARTS));
+    hands[1].add(Card(ACE, HEARTS));
+    hands[2].add(Card(JACK, DIAMONDS)); // left bower
+    hands[3].add(Card(KING, HEARTS));
+    DoubleDummySolver solver;
+    ASSERT_EQUAL(solver.solve(hands, HEARTS, 1, 0), 1);
+    ASSERT_EQUAL(solver.solve(hands, HEARTS, 1, 1), 0);
+    ASSERT_EQUAL(solver.solve(hands, SPADES, 1, 0), 0);
+}
+
+// A team holding the top five trumps takes every trick, whoever leads
+TEST(test_dd_all_trumps) {
+    CardSet hands[4];
+    Card top[] = {Card(JACK, SPADES), Card(JACK, CLUBS), Card(ACE, SPADES),
+                  Card(KING, SPADES), Card(QUEEN, SPADES)};
+    Card others[] = {Card(NINE, HEARTS), Card(TEN, HEARTS), Card(JACK, HEARTS),
+                     Card(QUEEN, HEARTS), Card(KING, HEARTS), Card(ACE, HEARTS),
+                     Card(NINE, DIAMONDS), Card(TEN, DIAMONDS), Card(JACK, DIAMONDS),
+                     Card(QUEEN, DIAMONDS), Card(KING, DIAMONDS), Card(ACE, DIAMONDS),
+                     Card(NINE, CLUBS), Card(TEN, CLUBS), Card(QUEEN, CLUBS)};
+    for (int i = 0; i < 5; ++i) {
+        hands[0].add(top[i]);
+        hands[1].add(others[i]);
+        hands[2].add(others[5 + i]);
+        hands[3].add(others[10 + i]);
+    }
+    DoubleDummySolver solver;
+    for (int leader = 0; leader < 4; ++leader) {
+        ASSERT_EQUAL(solver.solve(hands, SPADES, leader, 0), 5);
+        ASSERT_EQUAL(solver.solve(hands, SPADES, leader, 1), 0);
+    }
+}
+
+// The solver agrees with plain minimax on random deals
+TEST(test_dd_matches_brute_force) {
+    Rng rng(280);
+    DoubleDummySolver solver(10);
+    vector<Card> hands[4];
+    CardSet sets[4];
+    for (int deal_number = 0; deal_number < 400; ++deal_number) {
+        int n = (deal_number % 10 == 0) ? 4 : 3;
+        deal(rng, n, hands, sets);
+        Suit trump = static_cast<Suit>(rng.below(4));
+        int leader = static_cast<int>(rng.below(4));
+        vector<Card> trick;
+        int expected = brute_force(hands, trump, leader, trick);
+        ASSERT_EQUAL(solver.solve(sets, trump, leader, 0), expected);
+        ASSERT_EQUAL(solver.solve(sets, trump, leader, 1), n - expected);
+    }
+}
+
+// Positions part way through a trick, and the value of every move
+TEST(test_dd_mid_trick_and_moves) {
+    Rng rng(31);
+    DoubleDummySolver solver(10);
+    vector<Card> hands[4];
+    CardSet sets[4];
+    for (int deal_number = 0; deal_number < 300; ++deal_number) {
+        deal(rng, 3, hands, sets);
+        DoubleDummyPosition position;
+        position.trump = static_cast<Suit>(rng.below(4));
+        position.leader = static_cast<int>(rng.below(4));
+        position.played = static_cast<int>(rng.below(4));
+        vector<Card> trick;
+        for (int pos = 0; pos < position.played; ++pos) {
+            // any card will do for this test, legal or not
+            vector<Card> &hand = hands[(position.leader + pos) % 4];
+            Card c = hand.back();
+            hand.pop_back();
+            trick.push_back(c);
+            position.trick[pos] = c;
+        }
+        for (int seat = 0; seat < 4; ++seat) {
+            position.hands[seat] = CardSet();
+            for (const Card &c : hands[seat]) {
+                position.hands[seat].add(c);
+            }
+        }
+        int expected = brute_force(hands, position.trump, position.leader, trick);
+        ASSERT_EQUAL(solver.solve(position, 0), expected);
+
+        int mover = (position.leader + position.played) % 4;
+        Card moves[3];
+        int tricks[3];
+        int n = solver.solve_moves(position, moves, tricks);
+        ASSERT_TRUE(n >= 1);
+        int best = -1;
+        for (int i = 0; i < n; ++i) {
+            vector<Card> &hand = hands[mover];
+            auto it = find(hand.begin(), hand.end(), moves[i]);
+            ASSERT_TRUE(it != hand.end());
+            hand.erase(it);
+            trick.push_back(moves[i]);
+            int team0 = brute_force(hands, position.trump, position.leader, trick);
+            trick.pop_back();
+            hand.push_back(moves[i]);
+            ASSERT_EQUAL(tricks[i], (mover % 2 == 0) ? team0 : 3 - team0);
+            best = max(best, tricks[i]);
+        }
+        ASSERT_EQUAL(best, solver.solve(position, mover % 2));
+    }
+}
+
+// Full five-card deals give the same answer with a fresh or a warm table
+TEST(test_dd_table_reuse) {
+    Rng rng(7);
+    DoubleDummySolver warm;
+    vector<Card> hands[4];
+    CardSet sets[4];
+    for (int deal_number = 0; deal_number < 200; ++deal_number) {
+        deal(rng, 5, hands, sets);
+        Suit trump = static_cast<Suit>(deal_number % 4);
+        DoubleDummySolver fresh(8);
+        int tricks = fresh.solve(sets, trump, 1, 0);
+        ASSERT_TRUE(0 <= tricks && tricks <= 5);
+        ASSERT_EQUAL(warm.solve(sets, trump, 1, 0), tricks);
+        ASSERT_EQUAL(warm.solve(sets, trump, 1, 0), tricks);
+    }
+    ASSERT_TRUE(warm.nodes() > 0);
+    warm.clear();
+    ASSERT_EQUAL(warm.nodes(), 0u);
+}
+
+TEST_MAIN()
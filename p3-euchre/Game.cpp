@@ -0,0 +1,407 @@
+#include "Game.hpp"
+#include "Instrument.hpp"
+#include <cassert>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+template <class SeatT>
+BasicEuchreGame<SeatT>::BasicEuchreGame(Pack gamePack, bool shuffleCards,
+    int winPoints, vector<SeatT*> &playersInGame, ostream *out):
+    shuffle(shuffleCards), pointsNeededToWin(winPoints), transcript(out){
+        players = playersInGame;
+
+        pack = gamePack;
+        team1Points = 0;
+        team2Points = 0;
+    }
+
+template <class SeatT>
+GameResult BasicEuchreGame<SeatT>::startGame() {
+    while (team1Points < pointsNeededToWin && team2Points < pointsNeededToWin){
+        if (currentHand == stopHand){
+            transcript.flush();
+            return checkpoint().result;
+        }
+        if (checkpoints && currentHand % checkpointInterval == 0){
+            checkpoints->push_back(checkpoint());
+        }
+        // which hand(s);
+        if (transcript.enabled()) transcript << "Hand " << currentHand << '\n';
+        currentHand++;
+
+        Suit currentTrump = SPADES;
+        if (records){
+            record = HandRecord();
+            record.game = recordGame;
+            record.hand = currentHand - 1;
+            playsRecorded = 0;
+        }
+        for (int seat = 0; seat < 4; seat++){
+            players[seat]->new_hand(seat, dealerIndex % 4);
+        }
+        shufflePack();
+        dealCards(trumpCard);
+        if (records) record.upcard = Card_euchre_id(trumpCard);
+        if (transcript.enabled()){
+            // who is the dealer;
+            transcript << players[dealerIndex % 4]->get_name() << " deals" << '\n';
+            // upcard;
+            transcript << trumpCard << " turned up" << '\n';
+        }
+
+        playHand(currentTrump, dealerIndex);
+        if (records){
+            record.points[0] = team1Points;
+            record.points[1] = team2Points;
+            records->push_back(record);
+        }
+        dealerIndex++;
+    }
+
+    result.points[0] = team1Points;
+    result.points[1] = team2Points;
+    result.hands_played = currentHand;
+    result.winner = (team1Points >= pointsNeededToWin) ? 0 : 1;
+    if (transcript.enabled()){
+        transcript << players[result.winner]->get_name() << " and " <<
+        players[result.winner + 2]->get_name() << " win!" << '\n';
+        transcript.flush();
+    }
+    return result;
+}
+
+template <class SeatT>
+void BasicEuchreGame<SeatT>::set_line_buffered(bool on){
+    transcript.set_line_buffered(on);
+}
+
+template <class SeatT>
+void BasicEuchreGame<SeatT>::use_random_shuffle(uint64_t seed){
+    randomShuffle = true;
+    rng.reseed(seed);
+}
+
+template <class SeatT>
+void BasicEuchreGame<SeatT>::set_record(vector<HandRecord> *recordsOut,
+    uint32_t gameNumber){
+    assert(!recordsOut || pointsNeededToWin <= MAX_RECORDED_POINTS);
+    records = recordsOut;
+    recordGame = gameNumber;
+}
+
+template <class SeatT>
+void BasicEuchreGame<SeatT>::set_checkpoints(vector<GameCheckpoint> *checkpointsOut,
+    int interval){
+    checkpoints = checkpointsOut;
+    checkpointInterval = interval;
+}
+
+template <class SeatT>
+GameCheckpoint BasicEuchreGame<SeatT>::checkpoint() const{
+    GameCheckpoint saved;
+    saved.pack = pack;
+    saved.rng = rng;
+    saved.hand = currentHand;
+    saved.result = result;
+    saved.result.points[0] = team1Points;
+    saved.result.points[1] = team2Points;
+    saved.result.hands_played = currentHand;
+    return saved;
+}
+
+template <class SeatT>
+void BasicEuchreGame<SeatT>::restore(const GameCheckpoint &saved){
+    pack = saved.pack;
+    rng = saved.rng;
+    // one hand per dealer;
+    currentHand = dealerIndex = saved.hand;
+    result = saved.result;
+    team1Points = saved.result.points[0];
+    team2Points = saved.result.points[1];
+}
+
+template <class SeatT>
+void BasicEuchreGame<SeatT>::stop_before(int hand){
+    stopHand = hand;
+}
+
+template <class SeatT>
+void BasicEuchreGame<SeatT>::shufflePack(){
+    INSTRUMENT_PHASE(PHASE_SHUFFLE);
+    if (randomShuffle){
+        pack.shuffle(rng);
+    }
+    else if (shuffle == true){
+        pack.shuffle();
+    }
+    else{
+        pack.reset();
+    }
+}
+
+template <class SeatT>
+void BasicEuchreGame<SeatT>::dealOneCard(int playerIndex){
+    Card card = pack.deal_one();
+    if (records) record.hands[playerIndex] |= 1u << Card_euchre_id(card);
+    players[playerIndex]->add_card(card);
+}
+
+template <class SeatT>
+void BasicEuchreGame<SeatT>::dealTwoCards(int playerIndex){
+    dealOneCard(playerIndex);
+    dealOneCard(playerIndex);
+    return;
+}
+
+template <class SeatT>
+void BasicEuchreGame<SeatT>::dealThreeCards(int playerIndex){
+    dealOneCard(playerIndex);
+    dealOneCard(playerIndex);
+    dealOneCard(playerIndex);
+    return;
+}
+
+template <class SeatT>
+void BasicEuchreGame<SeatT>::dealCards(Card &firstCard){
+    INSTRUMENT_PHASE(PHASE_DEAL);
+
+    // first round;
+    for (int i = 1; i <= 4; i++){
+        if(i % 2 == 1){
+            dealThreeCards((dealerIndex + i) % 4);
+        }
+        else if (i % 2 == 0){
+            dealTwoCards((dealerIndex + i) % 4);
+        }
+    }
+
+    // second round;
+    for (int i = 1; i <= 4; i++){
+        if (i % 2 == 1){
+            dealTwoCards((dealerIndex + i) % 4);
+        }
+        else if (i % 2 == 0){
+            dealThreeCards((dealerIndex + i) % 4);
+        }
+    }
+
+    // trumpCard;
+    firstCard = pack.deal_one();
+}
+
+template <class SeatT>
+int BasicEuchreGame<SeatT>::selectTrump(int dealerIdx, const Card trumpCard,
+    Suit &trumpSuit){
+    INSTRUMENT_PHASE(PHASE_BID);
+
+    // round 1;
+    int round = 1;
+    for(int i = 1; i <= 4; i++){
+        int currentPlayer = (dealerIdx + i) % 4;
+        if (INSTRUMENT_CALL(players[currentPlayer], CALL_MAKE_TRUMP,
+            players[currentPlayer]->make_trump(trumpCard,
+            dealerIdx % 4 == currentPlayer, round, trumpSuit))){
+                if (transcript.enabled()){
+                    transcript << players[currentPlayer]->get_name() << " orders up "
+                    << trumpSuit << '\n';
+                }
+                INSTRUMENT_CALL(players[dealerIdx % 4], CALL_ADD_AND_DISCARD,
+                    players[dealerIdx % 4]->add_and_discard(trumpCard));
+                announceTrump(currentPlayer, trumpSuit, true);
+                return currentPlayer;
+        }
+        else if (transcript.enabled()){
+            transcript << players[currentPlayer]->get_name() <<
+                " passes" << '\n';
+        }
+    }
+
+    // round 2;
+    round = 2;
+    for (int i = 1; i <= 4; i++){
+        int currentPlayer = (dealerIdx + i) % 4;
+        if (INSTRUMENT_CALL(players[currentPlayer], CALL_MAKE_TRUMP,
+            players[currentPlayer]->make_trump(trumpCard,
+            dealerIdx % 4 == currentPlayer, round, trumpSuit))){
+                if (transcript.enabled()){
+                    transcript << players[currentPlayer]->get_name() << " orders up "
+                    << trumpSuit << "\n\n";
+                }
+                announceTrump(currentPlayer, trumpSuit, false);
+                return currentPlayer;
+        }
+        else if (transcript.enabled()){
+            transcript << players[currentPlayer]->get_name() <<
+                " passes" << '\n';
+        }
+    }
+    return dealerIdx % 4;
+}
+
+template <class SeatT>
+void BasicEuchreGame<SeatT>::printScores(){
+    transcript << players[0]->get_name() << " and " << players[2]->get_name() <<
+        " have " << team1Points << " points" << '\n';
+    transcript << players[1]->get_name() << " and " << players[3]->get_name() <<
+        " have " << team2Points << " points" << "\n\n";
+}
+
+template <class SeatT>
+void BasicEuchreGame<SeatT>::displayScoreMessage(int team1Score, int team2Score,
+    int trumpTeam){
+    INSTRUMENT_PHASE(PHASE_SCORE);
+    // the team that took the most tricks wins the hand;
+    int handWinner = (team1Score > team2Score) ? 0 : 1;
+    int tricksTaken = (handWinner == 0) ? team1Score : team2Score;
+    int &points = (handWinner == 0) ? team1Points : team2Points;
+    bool euchred = (handWinner + 1 != trumpTeam);
+    bool march = !euchred && tricksTaken == 5;
+
+    if (euchred){
+        points += 2;
+        result.euchres[handWinner]++;
+    }
+    else if (march){
+        points += 2;
+        result.marches[handWinner]++;
+    }
+    else{
+        points++;
+    }
+
+    if (transcript.enabled()){
+        transcript << players[handWinner]->get_name() << " and " <<
+            players[handWinner + 2]->get_name() << " win the hand" << '\n';
+        if (euchred){
+            transcript << "euchred!" << '\n';
+        }
+        else if (march){
+            transcript << "march!" << '\n';
+        }
+        printScores();
+    }
+}
+
+template <class SeatT>
+void BasicEuchreGame<SeatT>::announceTrump(int maker, Suit trumpSuit,
+    bool upcardTaken){
+    if (records){
+        record.bid = dealerIndex % 4 | maker << 2 | trumpSuit << 4 |
+            (upcardTaken ? 0 : 1) << 6;
+    }
+    for (SeatT *player : players){
+        player->trump_made(maker, trumpSuit, trumpCard, upcardTaken);
+    }
+}
+
+template <class SeatT>
+Card BasicEuchreGame<SeatT>::announcePlay(int seat, const Card &card){
+    if (records) record.plays[playsRecorded++] = Card_euchre_id(card);
+    for (SeatT *player : players){
+        player->card_played(seat, card);
+    }
+    return card;
+}
+
+template <class SeatT>
+int BasicEuchreGame<SeatT>::determineTrickWinner(const Suit trumpSuit,
+    int dealerIdx){
+    INSTRUMENT_PHASE(PHASE_TRICK);
+
+    // play a trick
+
+    // first player leads a card;
+    Card card1 = announcePlay(dealerIdx % 4,
+        INSTRUMENT_CALL(players[dealerIdx % 4], CALL_LEAD_CARD,
+            players[dealerIdx % 4]->lead_card(trumpSuit)));
+    if (transcript.enabled()){
+        transcript << card1 << " led by " << players[dealerIdx % 4]->get_name()
+            << '\n';
+    }
+    // second player leads a card;
+    Card card2 = announcePlay((dealerIdx + 1) % 4,
+        INSTRUMENT_CALL(players[(dealerIdx + 1) % 4], CALL_PLAY_CARD,
+            players[(dealerIdx + 1) % 4]->play_card(card1, trumpSuit)));
+    if (transcript.enabled()){
+        transcript << card2 << " played by " <<
+            players[(dealerIdx + 1) % 4]->get_name() << '\n';
+    }
+    // third player leads a card;
+    Card card3 = announcePlay((dealerIdx + 2) % 4,
+        INSTRUMENT_CALL(players[(dealerIdx + 2) % 4], CALL_PLAY_CARD,
+            players[(dealerIdx + 2) % 4]->play_card(card1, trumpSuit)));
+    if (transcript.enabled()){
+        transcript << card3 << " played by " <<
+            players[(dealerIdx + 2) % 4]->get_name() << '\n';
+    }
+    // forth player leads a card;
+    Card card4 = announcePlay((dealerIdx + 3) % 4,
+        INSTRUMENT_CALL(players[(dealerIdx + 3) % 4], CALL_PLAY_CARD,
+            players[(dealerIdx + 3) % 4]->play_card(card1, trumpSuit)));
+    if (transcript.enabled()){
+        transcript << card4 << " played by " <<
+            players[(dealerIdx + 3) % 4]->get_name() << '\n';
+    }
+
+    // find the winning card
+    Card winningCard = card1;
+
+    if (Card_less(winningCard, card2, card1, trumpSuit)){
+        winningCard = card2;
+    }
+    if (Card_less(winningCard, card3, card1, trumpSuit)){
+        winningCard = card3;
+    }
+    if (Card_less(winningCard, card4, card1, trumpSuit)){
+        winningCard = card4;
+    }
+
+    // find the card owner;
+    if (winningCard == card1) return dealerIdx % 4;
+    else if (winningCard == card2) return (dealerIdx + 1) % 4;
+    else if (winningCard == card3) return (dealerIdx + 2) % 4;
+    else if (winningCard == card4) return (dealerIdx + 3) % 4;
+    return -1;
+}
+
+template <class SeatT>
+void BasicEuchreGame<SeatT>::playHand(Suit trumpSuit, int dealerIdx){
+    int winningPlayer;
+    int team1Score = 0;
+    int team2Score = 0;
+    int trumpTeam = 0;
+    // make trump;
+    int trumpMaker = selectTrump(dealerIdx, trumpCard, trumpSuit);
+    // which is trump maker's team;
+    if (trumpMaker == 0 || trumpMaker == 2){
+        trumpTeam = 1;
+    }
+    else if (trumpMaker == 1 || trumpMaker == 3){
+        trumpTeam = 2;
+    }
+    // for first round; first left player of dealer leads;
+    winningPlayer = (dealerIdx + 1) % 4;
+    for(int i = 0; i < 5; i++){
+        winningPlayer = determineTrickWinner(trumpSuit, winningPlayer);
+        if (records) record.winners |= winningPlayer << (2 * i);
+        if (transcript.enabled()){
+            transcript << players[winningPlayer]->get_name() << " takes the trick" <<
+                "\n\n";
+        }
+        if (winningPlayer == 0 || winningPlayer == 2){
+            team1Score++;
+        }
+        else if(winningPlayer == 1 || winningPlayer == 3){
+            team2Score++;
+        }
+    }
+    // find hand winners;
+
+    displayScoreMessage(team1Score, team2Score, trumpTeam);
+}
+
+// the two seatings in use; other translation units only see declarations
+template class BasicEuchreGame<Player>;
+template class BasicEuchreGame<SimplePlayer>;
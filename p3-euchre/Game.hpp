@@ -0,0 +1,134 @@
+#ifndef GAME_HPP
+#define GAME_HPP
+/* Game.hpp
+ *
+ * Euchre game engine
+ */
+
+
+#include "GameRecord.hpp"
+#include "Pack.hpp"
+#include "Player.hpp"
+#include "SimplePlayer.hpp"
+#include "Random.hpp"
+#include "Transcript.hpp"
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+// Summary of a finished game.  Arrays are indexed by team: team 0 is
+// players 0 and 2, team 1 is players 1 and 3.
+struct GameResult {
+  int points[2] = {0, 0};   // final score
+  int marches[2] = {0, 0};  // hands the team made trump and took all 5 tricks
+  int euchres[2] = {0, 0};  // hands the team euchred the makers
+  int hands_played = 0;
+  int winner = 0;           // index of the winning team
+};
+
+// The state of a game between hands: everything startGame needs to play
+// on from the next hand.  Players start every hand afresh, so they are
+// not part of it.
+struct GameCheckpoint {
+  Pack pack;          // as the last hand's shuffle left it
+  Rng rng;            // the random shuffle's generator
+  int hand = 0;       // number of the next hand; its dealer is hand % 4
+  GameResult result;  // points, marches and euchres so far; hands_played
+                      // is hand, and winner is not set
+};
+
+// The game engine, parameterized on the seat type.  EuchreGame seats any
+// Player and calls them through the virtual interface, so humans and
+// computer players can share a table.  SimpleEuchreGame seats only
+// SimplePlayers; since that class is final, every strategy call is bound
+// at compile time and can be inlined into the game loop.
+template <class SeatT>
+class BasicEuchreGame {
+ public:
+  // REQUIRES: playersInGame holds exactly four players
+  // EFFECTS: Initializes a game between playersInGame.  The transcript is
+  //          written to out in large blocks, and is complete when
+  //          startGame returns.  If out is null the game is headless and
+  //          formats no text at all.
+  BasicEuchreGame(Pack gamePack, bool shuffleCards, int winPoints,
+                  std::vector<SeatT*> &playersInGame, std::ostream *out);
+
+  // EFFECTS: If on, the transcript is written a line at a time, so it
+  //          interleaves correctly with players that prompt on the same
+  //          stream (HumanPlayer uses cout).
+  void set_line_buffered(bool on);
+
+  // EFFECTS: Shuffles before every hand with a random shuffle seeded by
+  //          seed instead of the in shuffle, whatever shuffleCards was.
+  //          Games with the same seed deal the same hands.
+  void use_random_shuffle(std::uint64_t seed);
+
+  // REQUIRES: records is null, or the game is played to at most
+  //           MAX_RECORDED_POINTS
+  // EFFECTS: Appends a HandRecord of every hand startGame plays to
+  //          records, marked as game number gameNumber, or records
+  //          nothing if records is null.  records must outlive startGame.
+  void set_record(std::vector<HandRecord> *records, std::uint32_t gameNumber);
+
+  // EFFECTS: Saves a checkpoint to checkpoints before every hand whose
+  //          number is a multiple of interval.  checkpoints must outlive
+  //          startGame.
+  void set_checkpoints(std::vector<GameCheckpoint> *checkpoints, int interval);
+
+  // EFFECTS: Returns the state of the game before its next hand.
+  GameCheckpoint checkpoint() const;
+
+  // REQUIRES: this game was set up, shuffling included, as the one that
+  //           saved checkpoint
+  // EFFECTS: Puts the game back in the state checkpoint was saved in, so
+  //          startGame plays on from the hand after it.
+  void restore(const GameCheckpoint &checkpoint);
+
+  // EFFECTS: Makes startGame return before playing hand number hand, if
+  //          the game gets that far, with result.winner not set.  Calling
+  //          startGame again plays on from there.
+  void stop_before(int hand);
+
+  // EFFECTS: Plays hands until one team reaches the winning score and
+  //          returns the result.
+  GameResult startGame();
+
+ private:
+  std::vector<SeatT*> players;
+  Card trumpCard; // to make trump
+  Pack pack;
+  bool shuffle = false;
+  bool randomShuffle = false;
+  Rng rng;
+  int pointsNeededToWin;
+  int dealerIndex = 0;
+  int team1Points; int team2Points;
+  int currentHand = 0;
+  TranscriptWriter transcript;  // disabled when headless
+  GameResult result;
+  std::vector<HandRecord> *records = nullptr;
+  HandRecord record;            // the hand being played, if recording
+  std::uint32_t recordGame = 0;
+  int playsRecorded = 0;
+  std::vector<GameCheckpoint> *checkpoints = nullptr;
+  int checkpointInterval = 1;
+  int stopHand = -1;            // none
+
+  void shufflePack();
+  void dealOneCard(int playerIndex);
+  void dealTwoCards(int playerIndex);
+  void dealThreeCards(int playerIndex);
+  void dealCards(Card &firstCard);
+  int selectTrump(int dealerIdx, const Card trumpCard, Suit &trumpSuit);
+  void printScores();
+  void displayScoreMessage(int team1Score, int team2Score, int trumpTeam);
+  void announceTrump(int maker, Suit trumpSuit, bool upcardTaken);
+  Card announcePlay(int seat, const Card &card);
+  int determineTrickWinner(const Suit trumpSuit, int dealerIdx);
+  void playHand(Suit trumpSuit, int dealerIdx);
+};
+
+using EuchreGame = BasicEuchreGame<Player>;
+using SimpleEuchreGame = BasicEuchreGame<SimplePlayer>;
+
+#endif // GAME_HPP
@@ -0,0 +1,82 @@
+#include "GameRecord.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <ostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+// The file is this header followed by the records
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t record_size;
+};
+
+const char MAGIC[8] = {'E', 'U', 'C', 'H', 'R', 'E', 'G', 'R'};
+
+// bump when HandRecord changes
+const uint32_t VERSION = 2;
+
+} // namespace
+
+GameRecordWriter::GameRecordWriter(ostream &os_in) : os(os_in) {
+  FileHeader header;
+  memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.record_size = sizeof(HandRecord);
+  os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+}
+
+void GameRecordWriter::write(const vector<HandRecord> &records) {
+  lock_guard<mutex> guard(lock);
+  os.write(reinterpret_cast<const char *>(records.data()),
+           records.size() * sizeof(HandRecord));
+}
+
+bool GameRecordWriter::good() const {
+  lock_guard<mutex> guard(lock);
+  return os.good();
+}
+
+GameRecordReader::GameRecordReader(const char *path)
+  : records(nullptr), count(0), map_base(nullptr), map_size(0) {
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return;
+  }
+  struct stat info;
+  void *base = MAP_FAILED;
+  const size_t size = fstat(fd, &info) == 0 ? info.st_size : 0;
+  if (size >= sizeof(FileHeader) &&
+      (size - sizeof(FileHeader)) % sizeof(HandRecord) == 0) {
+    base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  // the mapping stays valid once the file is closed
+  close(fd);
+  if (base == MAP_FAILED) {
+    return;
+  }
+  const FileHeader *header = static_cast<const FileHeader *>(base);
+  if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header->version != VERSION || header->record_size != sizeof(HandRecord)) {
+    munmap(base, size);
+    return;
+  }
+  // records are read front to back far more often than at random
+  madvise(base, size, MADV_SEQUENTIAL);
+  map_base = base;
+  map_size = size;
+  records = reinterpret_cast<const HandRecord *>(header + 1);
+  count = (size - sizeof(FileHeader)) / sizeof(HandRecord);
+}
+
+GameRecordReader::~GameRecordReader() {
+  if (map_base) {
+    munmap(map_base, map_size);
+  }
+}
@@ -0,0 +1,140 @@
+#ifndef GAMERECORD_HPP
+#define GAMERECORD_HPP
+/* GameRecord.hpp
+ *
+ * A compact binary record of played hands, for training and statistics
+ * over many more games than a text transcript can hold.  Every hand is
+ * one fixed-size HandRecord: the dealt hands, upcard, dealer, the bid
+ * that made trump, all twenty cards played, who took each trick, and the
+ * score after the hand.  Cards are stored as Card_euchre_id, so a record
+ * is 52 bytes.
+ *
+ * A record file is a short header followed by the records, written in
+ * the machine's byte order.  GameRecordReader maps a file into memory and
+ * hands out the records in place, so reading them costs no parsing and
+ * no copying, and files larger than memory are paged in as they are used.
+ */
+
+
+#include "Card.hpp"
+#include "CardSet.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <vector>
+
+struct HandRecord {
+  std::uint32_t hands[4];   // cards dealt to each seat, one bit per
+                            // Card_euchre_id
+  std::uint32_t game;       // the number given to the game's recorder
+  std::uint16_t hand;       // hand number within the game, from 0
+  std::uint16_t winners;    // seat that took trick t, in bits 2t and 2t+1
+  std::uint8_t plays[20];   // Card_euchre_id of every card, in play order
+  std::uint8_t upcard;      // Card_euchre_id
+  std::uint8_t bid;         // dealer | maker << 2 | trump << 4
+                            // | (round - 1) << 6
+  std::uint8_t unused[2];   // zero
+  std::uint16_t points[2];  // score by team after the hand
+
+  //EFFECTS Returns the cards dealt to seat
+  CardSet dealt(int seat) const {
+    return CardSet(std::uint64_t(hands[seat]) << (NINE * 4));
+  }
+
+  //EFFECTS Returns the upcard
+  Card upcard_card() const {
+    return Card_from_euchre_id(static_cast<CardId>(upcard));
+  }
+
+  int dealer() const { return bid & 3; }
+  int maker() const { return (bid >> 2) & 3; }
+  Suit trump() const { return static_cast<Suit>((bid >> 4) & 3); }
+
+  //EFFECTS Returns the round trump was made in, 1 or 2.  Every seat
+  //  before the maker in that round passed.
+  int round() const { return (bid >> 6) + 1; }
+
+  //REQUIRES 0 <= trick < 5
+  //EFFECTS Returns the seat that took trick
+  int trick_winner(int trick) const { return (winners >> (2 * trick)) & 3; }
+
+  //REQUIRES 0 <= trick < 5
+  //EFFECTS Returns the seat that led trick
+  int trick_leader(int trick) const {
+    return trick == 0 ? (dealer() + 1) % 4 : trick_winner(trick - 1);
+  }
+
+  //REQUIRES 0 <= i < 20
+  //EFFECTS Returns play i, the card played (i % 4)th in trick i / 4
+  Card play(int i) const {
+    return Card_from_euchre_id(static_cast<CardId>(plays[i]));
+  }
+
+  //REQUIRES 0 <= i < 20
+  //EFFECTS Returns the seat that made play i
+  int play_seat(int i) const { return (trick_leader(i / 4) + i % 4) % 4; }
+};
+
+static_assert(sizeof(HandRecord) == 52, "HandRecord must stay packed");
+
+// The most points a recorded game can be played to, so that its final
+// scores and its hand numbers fit in a HandRecord
+const int MAX_RECORDED_POINTS = 32767;
+
+// Appends records to a record file
+class GameRecordWriter {
+public:
+  //REQUIRES os is open in binary mode
+  //EFFECTS Initializes a writer to os and writes the file header
+  explicit GameRecordWriter(std::ostream &os);
+
+  GameRecordWriter(const GameRecordWriter &) = delete;
+  GameRecordWriter & operator=(const GameRecordWriter &) = delete;
+
+  //EFFECTS Appends records to the file.  Several threads can write at
+  //  once; each call's records stay together.
+  void write(const std::vector<HandRecord> &records);
+
+  //EFFECTS Returns false if a write has failed
+  bool good() const;
+
+private:
+  std::ostream &os;
+  mutable std::mutex lock;
+};
+
+// The records of a file, mapped into memory
+class GameRecordReader {
+public:
+  //EFFECTS Initializes a reader of the record file at path.  If the file
+  //  cannot be mapped or is not a record file of this version, the reader
+  //  is not open and has no records.
+  explicit GameRecordReader(const char *path);
+
+  GameRecordReader(const GameRecordReader &) = delete;
+  GameRecordReader & operator=(const GameRecordReader &) = delete;
+
+  ~GameRecordReader();
+
+  //EFFECTS Returns true if the file was mapped
+  bool is_open() const { return map_base != nullptr; }
+
+  //EFFECTS Returns the number of records
+  std::size_t size() const { return count; }
+
+  //REQUIRES i < size()
+  //EFFECTS Returns record i
+  const HandRecord & operator[](std::size_t i) const { return records[i]; }
+
+  const HandRecord * begin() const { return records; }
+  const HandRecord * end() const { return records + count; }
+
+private:
+  const HandRecord *records;
+  std::size_t count;
+  void *map_base;            // the mapping, or null
+  std::size_t map_size;
+};
+
+#endif // GAMERECORD_HPP
@@ -0,0 +1,185 @@
+#include "GameRecord.hpp"
+#include "Game.hpp"
+#include "Pack.hpp"
+#include "SimplePlayer.hpp"
+#include "unit_test_framework.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+using namespace std;
+
+// Plays as a SimplePlayer and keeps every card the table reports
+class Listener : public Player {
+public:
+    Listener() : inner("Listener") {}
+
+    const string & get_name() const override { return inner.get_name(); }
+    void add_card(const Card &c) override { inner.add_card(c); }
+    bool make_trump(const Card &upcard, bool is_dealer, int round,
+                    Suit &order_up_suit) const override {
+        return inner.make_trump(upcard, is_dealer, round, order_up_suit);
+    }
+    void add_and_discard(const Card &c) override { inner.add_and_discard(c); }
+    Card lead_card(Suit trump) override { return inner.lead_card(trump); }
+    Card play_card(const Card &led, Suit trump) override {
+        return inner.play_card(led, trump);
+    }
+    void trump_made(int maker_in, Suit trump_in, const Card &, bool taken) override {
+        makers.push_back(maker_in);
+        trumps.push_back(trump_in);
+        rounds.push_back(taken ? 1 : 2);
+    }
+    void card_played(int seat, const Card &card) override {
+        seats.push_back(seat);
+        cards.push_back(card);
+    }
+
+    vector<int> makers, rounds, seats;
+    vector<Suit> trumps;
+    vector<Card> cards;
+
+private:
+    SimplePlayer inner;
+};
+
+// Plays a game of Listeners to points and returns its records
+static vector<HandRecord> record_game(Listener (&seats)[4], GameResult &result,
+                                      int points = 10) {
+    vector<Player*> players = {&seats[0], &seats[1], &seats[2], &seats[3]};
+    vector<HandRecord> records;
+    EuchreGame game(Pack(), false, points, players, nullptr);
+    game.use_random_shuffle(18);
+    game.set_record(&records, 7);
+    result = game.startGame();
+    return records;
+}
+
+TEST(test_hand_record_fields) {
+    HandRecord record = HandRecord();
+    record.hands[2] = 0x1F;
+    record.upcard = Card_euchre_id(Card(ACE, DIAMONDS));
+    record.bid = 3 | 1 << 2 | HEARTS << 4 | 1 << 6;
+    record.winners = 2 | 0 << 2 | 1 << 4;
+    record.plays[5] = Card_euchre_id(Card(NINE, CLUBS));
+    ASSERT_EQUAL(record.dealt(2).size(), 5);
+    ASSERT_EQUAL(record.dealt(2).lowest(), Card(NINE, SPADES));
+    ASSERT_EQUAL(record.upcard_card(), Card(ACE, DIAMONDS));
+    ASSERT_EQUAL(record.dealer(), 3);
+    ASSERT_EQUAL(record.maker(), 1);
+    ASSERT_EQUAL(record.trump(), HEARTS);
+    ASSERT_EQUAL(record.round(), 2);
+    ASSERT_EQUAL(record.trick_leader(0), 0);
+    ASSERT_EQUAL(record.trick_leader(1), 2);
+    ASSERT_EQUAL(record.trick_leader(3), 1);
+    ASSERT_EQUAL(record.play(5), Card(NINE, CLUBS));
+    // play 5 is the second card of trick 1, which seat 2 led
+    ASSERT_EQUAL(record.play_seat(5), 3);
+}
+
+// The record of a game says what the players were told, hand by hand
+TEST(test_game_record_matches_play) {
+    Listener seats[4];
+    GameResult result;
+    vector<HandRecord> records = record_game(seats, result);
+    ASSERT_EQUAL(records.size(), size_t(result.hands_played));
+    const Listener &seen = seats[0];
+    for (size_t h = 0; h < records.size(); ++h) {
+        const HandRecord &record = records[h];
+        ASSERT_EQUAL(record.game, 7u);
+        ASSERT_EQUAL(record.hand, h);
+        ASSERT_EQUAL(record.dealer(), int(h % 4));
+        ASSERT_EQUAL(record.maker(), seen.makers[h]);
+        ASSERT_EQUAL(record.trump(), seen.trumps[h]);
+        ASSERT_EQUAL(record.round(), seen.rounds[h]);
+        CardSet all;
+        for (int seat = 0; seat < 4; ++seat) {
+            ASSERT_EQUAL(record.dealt(seat).size(), 5);
+            all = all | record.dealt(seat);
+        }
+        ASSERT_EQUAL(all.size(), 20);
+        ASSERT_FALSE(all.contains(record.upcard_card()));
+        for (int i = 0; i < 20; ++i) {
+            ASSERT_EQUAL(record.play(i), seen.cards[h * 20 + i]);
+            ASSERT_EQUAL(record.play_seat(i), seen.seats[h * 20 + i]);
+        }
+    }
+    ASSERT_EQUAL(records.back().points[0], result.points[0]);
+    ASSERT_EQUAL(records.back().points[1], result.points[1]);
+}
+
+// Scores past what a byte holds are recorded as they are
+TEST(test_game_record_long_game) {
+    Listener seats[4];
+    GameResult result;
+    vector<HandRecord> records = record_game(seats, result, 1000);
+    ASSERT_TRUE(result.points[result.winner] >= 1000);
+    ASSERT_EQUAL(records.size(), size_t(result.hands_played));
+    int last[2] = {0, 0};
+    for (size_t h = 0; h < records.size(); ++h) {
+        ASSERT_EQUAL(records[h].hand, h);
+        for (int team = 0; team < 2; ++team) {
+            ASSERT_TRUE(records[h].points[team] >= last[team]);
+            last[team] = records[h].points[team];
+        }
+    }
+    ASSERT_EQUAL(records.back().points[0], result.points[0]);
+    ASSERT_EQUAL(records.back().points[1], result.points[1]);
+}
+
+// Records written to a file map back unchanged
+TEST(test_game_record_file_round_trip) {
+    Listener seats[4];
+    GameResult result;
+    vector<HandRecord> records = record_game(seats, result);
+    {
+        ofstream out("GameRecord_test.bin", ios::binary);
+        GameRecordWriter writer(out);
+        writer.write(records);
+        writer.write(records);
+        ASSERT_TRUE(writer.good());
+    }
+    GameRecordReader reader("GameRecord_test.bin");
+    ASSERT_TRUE(reader.is_open());
+    ASSERT_EQUAL(reader.size(), 2 * records.size());
+    ASSERT_EQUAL(memcmp(reader.begin(), records.data(),
+                        records.size() * sizeof(HandRecord)), 0);
+    ASSERT_EQUAL(memcmp(&reader[records.size()], records.data(),
+                        records.size() * sizeof(HandRecord)), 0);
+    remove("GameRecord_test.bin");
+}
+
+// A file of no records opens; a missing, cut short or foreign one does not
+TEST(test_game_record_bad_files) {
+    {
+        ofstream out("GameRecord_empty.bin", ios::binary);
+        GameRecordWriter writer(out);
+    }
+    GameRecordReader empty("GameRecord_empty.bin");
+    ASSERT_TRUE(empty.is_open());
+    ASSERT_EQUAL(empty.size(), 0u);
+    ASSERT_TRUE(empty.begin() == empty.end());
+    remove("GameRecord_empty.bin");
+
+    GameRecordReader missing("GameRecord_missing.bin");
+    ASSERT_FALSE(missing.is_open());
+    ASSERT_EQUAL(missing.size(), 0u);
+
+    {
+        ofstream out("GameRecord_short.bin", ios::binary);
+        GameRecordWriter writer(out);
+        out << "cut short";
+    }
+    GameRecordReader short_file("GameRecord_short.bin");
+    ASSERT_FALSE(short_file.is_open());
+    remove("GameRecord_short.bin");
+
+    ofstream("GameRecord_foreign.bin", ios::binary) << "NOTARECORDFILE!!";
+    GameRecordReader foreign("GameRecord_foreign.bin");
+    ASSERT_FALSE(foreign.is_open());
+    remove("GameRecord_foreign.bin");
+}
+
+TEST_MAIN()
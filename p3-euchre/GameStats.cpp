@@ -0,0 +1,215 @@
+#include "GameStats.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+
+const char *LEAD_KIND_NAMES[NUM_LEAD_KINDS] = {
+  "right bower", "left bower", "trump Ace", "trump King", "trump Queen",
+  "trump Ten", "trump Nine", "off Ace", "off King", "off Queen", "off Jack",
+  "off Ten", "off Nine"
+};
+
+const int BAR_WIDTH = 40;
+
+double percent(long count, long total) {
+  return total == 0 ? 0.0 : 100.0 * count / total;
+}
+
+// EFFECTS: Prints one histogram bar, scaled so that total fills it
+void print_bar(ostream &os, const string &label, long count, long total) {
+  const int width = total == 0 ? 0 : int(BAR_WIDTH * count / total);
+  os << "  " << left << setw(14) << label << right << setw(6)
+     << percent(count, total) << "% " << string(width, '#') << ' ' << count
+     << '\n';
+}
+
+// EFFECTS: Prints a CSV row; name_key is the first two columns
+void print_row(ostream &os, const string &name_key, long count, long total) {
+  os << name_key << ',' << count << ',' << total << '\n';
+}
+
+} // namespace
+
+int LeadKind_of(const Card &card, Suit trump) {
+  if (card.is_right_bower(trump)) {
+    return 0;
+  }
+  if (card.is_left_bower(trump)) {
+    return 1;
+  }
+  const int below_ace = ACE - card.get_rank();
+  if (card.get_suit() == trump) {
+    // the trump Jack is the right bower, so Ten and Nine move up one
+    return 2 + (card.get_rank() < JACK ? below_ace - 1 : below_ace);
+  }
+  return 7 + below_ace;
+}
+
+const char * LeadKind_name(int kind) {
+  return LEAD_KIND_NAMES[kind];
+}
+
+void GameStats::add_hand(const HandRecord &record) {
+  ++hand_count;
+  const Suit trump = record.trump();
+  const int maker_team = record.maker() % 2;
+  int tricks = 0;
+  for (int trick = 0; trick < 5; ++trick) {
+    const int leader = record.trick_leader(trick);
+    const int winner = record.trick_winner(trick);
+    tricks += winner % 2 == maker_team;
+    const int kind = LeadKind_of(record.play(4 * trick), trump);
+    ++lead_count[kind];
+    lead_win_count[kind] += winner == leader;
+  }
+  ++tricks_taken[tricks];
+  // makers score 1, or 2 for a march; defenders score 2 for a euchre
+  const bool made = tricks >= 3;
+  const int winning_team = made ? maker_team : 1 - maker_team;
+  const int points = (tricks == 5 || !made) ? 2 : 1;
+  ++points_scored[winning_team][points];
+  ++points_scored[1 - winning_team][0];
+  add_bids(record);
+}
+
+void GameStats::add_bids(const HandRecord &record) {
+  const int dealer = record.dealer();
+  const int maker = record.maker();
+  // everyone before the maker passed, and in round 2 all four passed in
+  // round 1 first
+  for (int round = 1; round <= record.round(); ++round) {
+    for (int position = 0; position < 4; ++position) {
+      const int seat = (dealer + 1 + position) % 4;
+      ++offer_count[round - 1][seat][position];
+      if (round == record.round() && seat == maker) {
+        ++order_count[round - 1][seat][position];
+        break;
+      }
+    }
+  }
+}
+
+void GameStats::merge(const GameStats &other) {
+  hand_count += other.hand_count;
+  for (int tricks = 0; tricks <= 5; ++tricks) {
+    tricks_taken[tricks] += other.tricks_taken[tricks];
+  }
+  for (int team = 0; team < 2; ++team) {
+    for (int points = 0; points <= 2; ++points) {
+      points_scored[team][points] += other.points_scored[team][points];
+    }
+  }
+  for (int round = 0; round < 2; ++round) {
+    for (int seat = 0; seat < 4; ++seat) {
+      for (int position = 0; position < 4; ++position) {
+        offer_count[round][seat][position] += other.offer_count[round][seat][position];
+        order_count[round][seat][position] += other.order_count[round][seat][position];
+      }
+    }
+  }
+  for (int kind = 0; kind < NUM_LEAD_KINDS; ++kind) {
+    lead_count[kind] += other.lead_count[kind];
+    lead_win_count[kind] += other.lead_win_count[kind];
+  }
+}
+
+long GameStats::euchres() const {
+  return tricks_taken[0] + tricks_taken[1] + tricks_taken[2];
+}
+
+void GameStats::print(ostream &os) const {
+  os << fixed << setprecision(1);
+  os << hand_count << " hands\nTricks taken by the makers\n";
+  for (int tricks = 0; tricks <= 5; ++tricks) {
+    print_bar(os, to_string(tricks), tricks_taken[tricks], hand_count);
+  }
+  os << "Points per hand\n";
+  for (int team = 0; team < 2; ++team) {
+    for (int points = 0; points <= 2; ++points) {
+      print_bar(os, "team " + to_string(team) + ": " + to_string(points),
+                points_scored[team][points], hand_count);
+    }
+  }
+  os << "Order-up rate by seat, position from the dealer's left"
+     << " (- if never asked)\n";
+  for (int round = 1; round <= 2; ++round) {
+    for (int seat = 0; seat < 4; ++seat) {
+      os << "  round " << round << " seat " << seat << ':';
+      for (int position = 0; position < 4; ++position) {
+        const long asked = offers(round, seat, position);
+        if (asked == 0) {
+          os << setw(8) << '-';
+          continue;
+        }
+        os << setw(7) << percent(orders(round, seat, position), asked) << '%';
+      }
+      os << '\n';
+    }
+  }
+  os << "Tricks won by the card led\n";
+  for (int kind = 0; kind < NUM_LEAD_KINDS; ++kind) {
+    print_bar(os, LEAD_KIND_NAMES[kind], lead_win_count[kind], lead_count[kind]);
+  }
+  os << defaultfloat;
+}
+
+void GameStats::print_csv(ostream &os) const {
+  os << "statistic,key,count,total\n";
+  for (int tricks = 0; tricks <= 5; ++tricks) {
+    print_row(os, "maker_tricks," + to_string(tricks), tricks_taken[tricks],
+              hand_count);
+  }
+  for (int team = 0; team < 2; ++team) {
+    for (int points = 0; points <= 2; ++points) {
+      print_row(os, "team_points," + to_string(team) + ' ' + to_string(points),
+                points_scored[team][points], hand_count);
+    }
+  }
+  for (int round = 1; round <= 2; ++round) {
+    for (int seat = 0; seat < 4; ++seat) {
+      for (int position = 0; position < 4; ++position) {
+        const string key = to_string(round) + ' ' + to_string(seat) + ' ' +
+                           to_string(position);
+        print_row(os, "order_up," + key, orders(round, seat, position),
+                  offers(round, seat, position));
+      }
+    }
+  }
+  for (int kind = 0; kind < NUM_LEAD_KINDS; ++kind) {
+    print_row(os, string("lead_wins,") + LEAD_KIND_NAMES[kind],
+              lead_win_count[kind], lead_count[kind]);
+  }
+}
+
+GameStats GameStats_of(const HandRecord *records, size_t count, int threads) {
+  if (threads <= 0) {
+    threads = max(1u, thread::hardware_concurrency());
+  }
+  const size_t parts = max<size_t>(1, min<size_t>(threads, count));
+  vector<GameStats> stats(parts);
+  auto count_part = [&](size_t part) {
+    for (size_t i = count * part / parts; i < count * (part + 1) / parts; ++i) {
+      stats[part].add_hand(records[i]);
+    }
+  };
+  vector<thread> workers;
+  for (size_t part = 1; part < parts; ++part) {
+    workers.emplace_back(count_part, part);
+  }
+  // the calling thread works too
+  count_part(0);
+  for (thread &worker : workers) {
+    worker.join();
+  }
+  for (size_t part = 1; part < parts; ++part) {
+    stats[0].merge(stats[part]);
+  }
+  return stats[0];
+}
@@ -0,0 +1,110 @@
+#ifndef GAMESTATS_HPP
+#define GAMESTATS_HPP
+/* GameStats.hpp
+ *
+ * Statistics over many played hands, gathered from their HandRecords as
+ * the hands are played or read back from a record file, so no transcript
+ * has to be parsed.  Each hand adds to counts only: how many tricks the
+ * makers took, the points each team scored, which seats ordered up trump
+ * in which round, and how often each kind of card led won its trick.
+ *
+ * Adding a hand touches nothing but the GameStats it is added to, so
+ * threads playing games in parallel each keep their own and merge them
+ * when they finish, with no locks or atomics while they play.
+ */
+
+
+#include "Card.hpp"
+#include "GameRecord.hpp"
+#include <cstddef>
+#include <iosfwd>
+
+// Kinds of card led, by their place in the trump order: the seven trumps
+// from the right bower down, then the six ranks of the other suits
+const int NUM_LEAD_KINDS = 13;
+
+//REQUIRES card is Nine or higher
+//EFFECTS Returns the kind of card, 0 to NUM_LEAD_KINDS - 1, when trump
+//  is trump
+int LeadKind_of(const Card &card, Suit trump);
+
+//REQUIRES 0 <= kind < NUM_LEAD_KINDS
+//EFFECTS Returns the name of kind, such as "right bower" or "off Ace"
+const char * LeadKind_name(int kind);
+
+class GameStats {
+public:
+  //EFFECTS Adds the hand record holds
+  void add_hand(const HandRecord &record);
+
+  //EFFECTS Adds the counts in other to these
+  void merge(const GameStats &other);
+
+  long hands() const { return hand_count; }
+
+  //REQUIRES 0 <= tricks <= 5
+  //EFFECTS Returns the hands in which the makers took tricks tricks
+  long maker_tricks(int tricks) const { return tricks_taken[tricks]; }
+
+  //EFFECTS Returns the hands in which the makers took all five tricks
+  long marches() const { return tricks_taken[5]; }
+
+  //EFFECTS Returns the hands in which the makers took two tricks or fewer
+  long euchres() const;
+
+  //REQUIRES 0 <= team < 2, 0 <= points <= 2
+  //EFFECTS Returns the hands in which team scored points points
+  long team_points(int team, int points) const {
+    return points_scored[team][points];
+  }
+
+  //REQUIRES round is 1 or 2, 0 <= seat < 4, 0 <= position < 4
+  //EFFECTS Returns the times seat was asked to make trump in round from
+  //  position, counted from the dealer's left (3 is the dealer)
+  long offers(int round, int seat, int position) const {
+    return offer_count[round - 1][seat][position];
+  }
+
+  //REQUIRES as for offers
+  //EFFECTS Returns the times seat ordered up trump when asked that way
+  long orders(int round, int seat, int position) const {
+    return order_count[round - 1][seat][position];
+  }
+
+  //REQUIRES 0 <= kind < NUM_LEAD_KINDS
+  //EFFECTS Returns the tricks led with kind of card, and how many of
+  //  those the card led won
+  long leads(int kind) const { return lead_count[kind]; }
+  long lead_wins(int kind) const { return lead_win_count[kind]; }
+
+  //EFFECTS Prints the counts as histograms and tables of rates
+  void print(std::ostream &os) const;
+
+  //EFFECTS Prints the counts as CSV with columns statistic,key,count,
+  //  total: count of total hands, offers or leads.  Keys are
+  //    maker_tricks  tricks
+  //    team_points   team and points, as "0 2"
+  //    order_up      round, seat and position, as "1 2 3"
+  //    lead_wins     the LeadKind_name
+  void print_csv(std::ostream &os) const;
+
+private:
+  long hand_count = 0;
+  long tricks_taken[6] = {};
+  long points_scored[2][3] = {};
+  long offer_count[2][4][4] = {};
+  long order_count[2][4][4] = {};
+  long lead_count[NUM_LEAD_KINDS] = {};
+  long lead_win_count[NUM_LEAD_KINDS] = {};
+
+  // EFFECTS: Counts the bidding that made trump in record
+  void add_bids(const HandRecord &record);
+};
+
+//REQUIRES threads >= 0
+//EFFECTS Returns the stats of count records, counted by up to threads
+//  threads (0 means one per hardware thread) that each take a range of
+//  the records and merge their counts at the end
+GameStats GameStats_of(const HandRecord *records, std::size_t count, int threads);
+
+#endif // GAMESTATS_HPP
@@ -0,0 +1,189 @@
+#include "GameStats.hpp"
+#include "unit_test_framework.hpp"
+
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+// Returns HandRecord::bid for a hand dealt by dealer with trump made by
+// maker in round
+static uint8_t bid_of(int dealer, int maker, Suit trump, int round) {
+    return uint8_t(dealer | maker << 2 | trump << 4 | (round - 1) << 6);
+}
+
+// Returns a hand with bid whose trick t is led with leads[t] and taken by
+// seat winners[t].  The stats read nothing else, so no cards are dealt.
+static HandRecord hand_of(uint8_t bid, const vector<int> &winners,
+                          const vector<Card> &leads) {
+    HandRecord record = {};
+    record.bid = bid;
+    for (int trick = 0; trick < 5; ++trick) {
+        record.winners |= uint16_t(winners[trick] << (2 * trick));
+        record.plays[4 * trick] = uint8_t(Card_euchre_id(leads[trick]));
+    }
+    return record;
+}
+
+// Three hands with known counts:
+//   a march by seat 2, who ordered up Spades in round 1 from position 1
+//   a euchre of seat 1, the dealer, who named Hearts in round 2
+//   three tricks for seat 3, who ordered up Clubs in round 1 from position 0
+static vector<HandRecord> three_hands() {
+    return {
+        hand_of(bid_of(0, 2, SPADES, 1), {2, 2, 2, 0, 0},
+                {Card(ACE, HEARTS), Card(JACK, SPADES), Card(JACK, CLUBS),
+                 Card(KING, DIAMONDS), Card(NINE, SPADES)}),
+        hand_of(bid_of(1, 1, HEARTS, 2), {2, 0, 1, 3, 2},
+                {Card(ACE, CLUBS), Card(QUEEN, HEARTS), Card(TEN, SPADES),
+                 Card(NINE, DIAMONDS), Card(KING, CLUBS)}),
+        hand_of(bid_of(2, 3, CLUBS, 1), {3, 1, 1, 0, 2},
+                {Card(JACK, CLUBS), Card(ACE, HEARTS), Card(ACE, CLUBS),
+                 Card(TEN, DIAMONDS), Card(QUEEN, SPADES)}),
+    };
+}
+
+static GameStats stats_of(const vector<HandRecord> &records) {
+    GameStats stats;
+    for (const HandRecord &record : records) {
+        stats.add_hand(record);
+    }
+    return stats;
+}
+
+static string csv_of(const GameStats &stats) {
+    ostringstream csv;
+    stats.print_csv(csv);
+    return csv.str();
+}
+
+TEST(test_lead_kinds) {
+    ASSERT_EQUAL(LeadKind_of(Card(JACK, SPADES), SPADES), 0);
+    ASSERT_EQUAL(LeadKind_of(Card(JACK, CLUBS), SPADES), 1);
+    ASSERT_EQUAL(LeadKind_of(Card(ACE, SPADES), SPADES), 2);
+    ASSERT_EQUAL(LeadKind_of(Card(QUEEN, SPADES), SPADES), 4);
+    ASSERT_EQUAL(LeadKind_of(Card(TEN, SPADES), SPADES), 5);
+    ASSERT_EQUAL(LeadKind_of(Card(NINE, SPADES), SPADES), 6);
+    ASSERT_EQUAL(LeadKind_of(Card(ACE, HEARTS), SPADES), 7);
+    ASSERT_EQUAL(LeadKind_of(Card(JACK, HEARTS), SPADES), 10);
+    ASSERT_EQUAL(LeadKind_of(Card(NINE, CLUBS), SPADES), 12);
+    ASSERT_EQUAL(string(LeadKind_name(1)), "left bower");
+    ASSERT_EQUAL(string(LeadKind_name(12)), "off Nine");
+
+    // one of each trump, three of each off rank but the Jack
+    for (int trump = SPADES; trump <= DIAMONDS; ++trump) {
+        int cards[NUM_LEAD_KINDS] = {};
+        for (CardId id = 0; id < NUM_EUCHRE_CARDS; ++id) {
+            ++cards[LeadKind_of(Card_from_euchre_id(id), Suit(trump))];
+        }
+        for (int kind = 0; kind < 7; ++kind) {
+            ASSERT_EQUAL(cards[kind], 1);
+        }
+        for (int kind = 7; kind < NUM_LEAD_KINDS; ++kind) {
+            ASSERT_EQUAL(cards[kind], kind == 10 ? 2 : 3);
+        }
+    }
+}
+
+TEST(test_stats_tricks_and_points) {
+    const GameStats stats = stats_of(three_hands());
+    ASSERT_EQUAL(stats.hands(), 3);
+    const long tricks[6] = {0, 0, 1, 1, 0, 1};
+    for (int taken = 0; taken <= 5; ++taken) {
+        ASSERT_EQUAL(stats.maker_tricks(taken), tricks[taken]);
+    }
+    ASSERT_EQUAL(stats.marches(), 1);
+    ASSERT_EQUAL(stats.euchres(), 1);
+    // team 0 scores 2 for the march and 2 for the euchre, team 1 scores 1
+    const long points[2][3] = {{1, 0, 2}, {2, 1, 0}};
+    for (int team = 0; team < 2; ++team) {
+        for (int scored = 0; scored <= 2; ++scored) {
+            ASSERT_EQUAL(stats.team_points(team, scored), points[team][scored]);
+        }
+    }
+}
+
+TEST(test_stats_bids) {
+    const GameStats stats = stats_of(three_hands());
+    // offers[round - 1][seat][position]; the round 2 hand was offered
+    // to all four seats in round 1 first
+    long offers[2][4][4] = {};
+    offers[0][1][0] = offers[0][2][1] = 1;
+    offers[0][2][0] = offers[0][3][1] = offers[0][0][2] = offers[0][1][3] = 1;
+    offers[1][2][0] = offers[1][3][1] = offers[1][0][2] = offers[1][1][3] = 1;
+    offers[0][3][0] = 1;
+    long orders[2][4][4] = {};
+    orders[0][2][1] = orders[1][1][3] = orders[0][3][0] = 1;
+    for (int round = 1; round <= 2; ++round) {
+        for (int seat = 0; seat < 4; ++seat) {
+            for (int position = 0; position < 4; ++position) {
+                ASSERT_EQUAL(stats.offers(round, seat, position),
+                             offers[round - 1][seat][position]);
+                ASSERT_EQUAL(stats.orders(round, seat, position),
+                             orders[round - 1][seat][position]);
+            }
+        }
+    }
+}
+
+TEST(test_stats_leads) {
+    const GameStats stats = stats_of(three_hands());
+    const long leads[NUM_LEAD_KINDS] = {2, 1, 1, 0, 1, 0, 1, 3, 2, 1, 0, 2, 1};
+    const long wins[NUM_LEAD_KINDS] = {2, 1, 1, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0};
+    for (int kind = 0; kind < NUM_LEAD_KINDS; ++kind) {
+        ASSERT_EQUAL(stats.leads(kind), leads[kind]);
+        ASSERT_EQUAL(stats.lead_wins(kind), wins[kind]);
+    }
+}
+
+// Counting in parts and merging gives the same counts as counting once
+TEST(test_stats_merge) {
+    vector<HandRecord> records;
+    for (int copy = 0; copy < 7; ++copy) {
+        const vector<HandRecord> hands = three_hands();
+        records.insert(records.end(), hands.begin(), hands.end());
+    }
+    const GameStats whole = stats_of(records);
+    ASSERT_EQUAL(whole.hands(), 21);
+    ASSERT_EQUAL(whole.marches(), 7);
+    ASSERT_EQUAL(whole.lead_wins(0), 14);
+    GameStats first;
+    GameStats second;
+    for (size_t i = 0; i < records.size(); ++i) {
+        (i % 3 == 0 ? first : second).add_hand(records[i]);
+    }
+    first.merge(second);
+    ASSERT_EQUAL(csv_of(first), csv_of(whole));
+    for (int threads : {1, 3, 0}) {
+        ASSERT_EQUAL(csv_of(GameStats_of(records.data(), records.size(), threads)),
+                     csv_of(whole));
+    }
+    ASSERT_EQUAL(GameStats_of(records.data(), 0, 4).hands(), 0);
+}
+
+TEST(test_stats_output) {
+    const GameStats stats = stats_of(three_hands());
+    const string csv = csv_of(stats);
+    istringstream lines(csv);
+    string line;
+    int rows = 0;
+    getline(lines, line);
+    ASSERT_EQUAL(line, "statistic,key,count,total");
+    while (getline(lines, line)) {
+        ++rows;
+    }
+    ASSERT_EQUAL(rows, 6 + 6 + 32 + NUM_LEAD_KINDS);
+    ASSERT_TRUE(csv.find("\nmaker_tricks,5,1,3\n") != string::npos);
+    ASSERT_TRUE(csv.find("\nteam_points,0 2,2,3\n") != string::npos);
+    ASSERT_TRUE(csv.find("\norder_up,2 1 3,1,1\n") != string::npos);
+    ASSERT_TRUE(csv.find("\norder_up,1 0 0,0,0\n") != string::npos);
+    ASSERT_TRUE(csv.find("\nlead_wins,right bower,2,2\n") != string::npos);
+    ASSERT_TRUE(csv.find("\nlead_wins,off Ace,1,3\n") != string::npos);
+
+    ostringstream text;
+    stats.print(text);
+    ASSERT_TRUE(text.str().find("3 hands\nTricks taken by the makers") != string::npos);
+    ASSERT_TRUE(text.str().find("right bower") != string::npos);
+}
+
+TEST_MAIN()
@@ -0,0 +1,145 @@
+#include "Game.hpp"
+#include "Pack.hpp"
+#include "Player.hpp"
+#include "SimplePlayer.hpp"
+#include "unit_test_framework.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+// Counts heap allocations so tests can check the game loop makes none
+static long allocations = 0;
+
+void * operator new(size_t size) {
+    ++allocations;
+    if (void *p = malloc(size ? size : 1)) {
+        return p;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+static vector<Player*> make_simple_players() {
+    vector<Player*> players;
+    players.push_back(Player_factory("Adi", "Simple"));
+    players.push_back(Player_factory("Barbara", "Simple"));
+    players.push_back(Player_factory("Chi-Chih", "Simple"));
+    players.push_back(Player_factory("Dabbala", "Simple"));
+    return players;
+}
+
+static GameResult play_game(bool shuffle, int points, ostream *out,
+                            bool random = false, uint64_t seed = 0) {
+    vector<Player*> players = make_simple_players();
+    EuchreGame game(Pack(), shuffle, points, players, out);
+    if (random) {
+        game.use_random_shuffle(seed);
+    }
+    GameResult result = game.startGame();
+    for (Player *p : players) {
+        delete p;
+    }
+    return result;
+}
+
+// A headless game writes nothing
+TEST(test_game_headless_no_output) {
+    ostringstream oss;
+    streambuf *old = cout.rdbuf(oss.rdbuf());
+    play_game(true, 10, nullptr);
+    cout.rdbuf(old);
+    ASSERT_EQUAL(oss.str(), "");
+}
+
+// Headless and verbose games produce the same result, team by team
+TEST(test_game_headless_matches_verbose) {
+    for (uint64_t seed = 0; seed < 5; ++seed) {
+        ostringstream oss;
+        GameResult verbose = play_game(true, 30, &oss, true, seed);
+        GameResult headless = play_game(true, 30, nullptr, true, seed);
+        ASSERT_FALSE(oss.str().empty());
+        ASSERT_EQUAL(verbose.hands_played, headless.hands_played);
+        ASSERT_EQUAL(verbose.winner, headless.winner);
+        for (int team = 0; team < 2; ++team) {
+            ASSERT_EQUAL(verbose.points[team], headless.points[team]);
+            ASSERT_EQUAL(verbose.marches[team], headless.marches[team]);
+            ASSERT_EQUAL(verbose.euchres[team], headless.euchres[team]);
+        }
+    }
+}
+
+// Result counters agree with the transcript
+TEST(test_game_result_counts) {
+    ostringstream oss;
+    GameResult result = play_game(true, 10, &oss);
+    string text = oss.str();
+    int marches = 0;
+    int euchres = 0;
+    for (size_t pos = text.find("march!"); pos != string::npos;
+         pos = text.find("march!", pos + 1)) {
+        ++marches;
+    }
+    for (size_t pos = text.find("euchred!"); pos != string::npos;
+         pos = text.find("euchred!", pos + 1)) {
+        ++euchres;
+    }
+    ASSERT_EQUAL(result.marches[0] + result.marches[1], marches);
+    ASSERT_EQUAL(result.euchres[0] + result.euchres[1], euchres);
+    ASSERT_TRUE(result.points[result.winner] >= 10);
+    ASSERT_TRUE(result.points[1 - result.winner] < 10);
+}
+
+// After setup a headless game of computer players never allocates
+TEST(test_game_no_allocations) {
+    vector<Player*> players = make_simple_players();
+    EuchreGame game(Pack(), false, 10, players, nullptr);
+    game.use_random_shuffle(3);
+    long before = allocations;
+    game.startGame();
+    ASSERT_EQUAL(allocations, before);
+    for (Player *p : players) {
+        delete p;
+    }
+}
+
+// The statically dispatched engine plays exactly like the virtual one
+TEST(test_simple_game_matches_game) {
+    ostringstream virtual_out;
+    play_game(true, 10, &virtual_out, true, 77);
+
+    SimplePlayer seats[4] = {SimplePlayer("Adi"), SimplePlayer("Barbara"),
+                             SimplePlayer("Chi-Chih"), SimplePlayer("Dabbala")};
+    vector<SimplePlayer*> players = {&seats[0], &seats[1], &seats[2],
+                                     &seats[3]};
+    ostringstream static_out;
+    SimpleEuchreGame game(Pack(), true, 10, players, &static_out);
+    game.use_random_shuffle(77);
+    game.startGame();
+    ASSERT_EQUAL(virtual_out.str(), static_out.str());
+}
+
+// A seeded game replays exactly
+TEST(test_game_random_shuffle_replays) {
+    ostringstream first;
+    ostringstream second;
+    ostringstream other;
+    play_game(true, 10, &first, true, 2024);
+    play_game(true, 10, &second, true, 2024);
+    play_game(true, 10, &other, true, 2025);
+    ASSERT_EQUAL(first.str(), second.str());
+    ASSERT_NOT_EQUAL(first.str(), other.str());
+}
+
+TEST_MAIN()
@@ -0,0 +1,85 @@
+#ifndef HAND_HPP
+#define HAND_HPP
+/* Hand.hpp
+ *
+ * A player's hand stored inline in a fixed-size array, so adding and
+ * removing cards never touches the heap.  Room is left for one card over
+ * MAX_HAND_SIZE, which the dealer holds briefly when picking up the
+ * upcard.
+ */
+
+
+#include "Card.hpp"
+#include "Player.hpp"
+#include <array>
+#include <cassert>
+
+class Hand {
+public:
+  static constexpr int CAPACITY = Player::MAX_HAND_SIZE + 1;
+
+  //EFFECTS Initializes an empty hand
+  Hand() : count(0) {}
+
+  //EFFECTS Returns the number of cards in the hand
+  int size() const { return count; }
+
+  //EFFECTS Returns true if the hand has no cards
+  bool empty() const { return count == 0; }
+
+  //REQUIRES 0 <= i < size()
+  //EFFECTS Returns the card at position i
+  const Card & operator[](int i) const {
+    assert(0 <= i && i < count);
+    return cards[i];
+  }
+
+  const Card * begin() const { return cards.data(); }
+  const Card * end() const { return cards.data() + count; }
+
+  //REQUIRES size() < CAPACITY
+  //EFFECTS Adds c after the last card
+  void push_back(const Card &c) {
+    assert(count < CAPACITY);
+    cards[count++] = c;
+  }
+
+  //REQUIRES size() < CAPACITY and the hand is sorted by operator<
+  //EFFECTS Adds c, keeping the hand sorted
+  void insert_sorted(const Card &c) {
+    assert(count < CAPACITY);
+    int i = count++;
+    for (; i > 0 && c < cards[i - 1]; --i) {
+      cards[i] = cards[i - 1];
+    }
+    cards[i] = c;
+  }
+
+  //REQUIRES 0 <= i < size()
+  //EFFECTS Removes and returns the card at position i.  The last card
+  //  moves into its place, so order is not kept.  O(1).
+  Card swap_remove(int i) {
+    assert(0 <= i && i < count);
+    Card removed = cards[i];
+    cards[i] = cards[--count];
+    return removed;
+  }
+
+  //REQUIRES 0 <= i < size()
+  //EFFECTS Removes and returns the card at position i, keeping the other
+  //  cards in order
+  Card remove_at(int i) {
+    assert(0 <= i && i < count);
+    Card removed = cards[i];
+    for (--count; i < count; ++i) {
+      cards[i] = cards[i + 1];
+    }
+    return removed;
+  }
+
+private:
+  std::array<Card, CAPACITY> cards;
+  int count;
+};
+
+#endif // HAND_HPP
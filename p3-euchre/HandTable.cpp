@@ -0,0 +1,165 @@
+#include "HandTable.hpp"
+#include "Deal.hpp"
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+namespace {
+
+// The file is this header followed by the entries, in table order
+struct FileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t entry_size;
+};
+
+const char MAGIC[8] = {'E', 'U', 'C', 'H', 'R', 'E', 'H', 'T'};
+
+// bump when HandStrength or the bid score changes
+const uint32_t VERSION = 2;
+
+const size_t NUM_ENTRIES = size_t(NUM_HANDS) * 4;
+
+const Suit SUITS[] = {SPADES, HEARTS, CLUBS, DIAMONDS};
+
+// The bid score's points.  Each trump scores by rank, long trumps and
+// voids a little for ruffing, and off-suit Aces, and Kings behind them,
+// about what a middling trump does.
+const int TRUMP_VALUE[] = {6, 7, 0, 8, 10, 12};  // Nine .. Ace, not Jack
+const int RIGHT_BOWER_VALUE = 16;
+const int LEFT_BOWER_VALUE = 14;
+const int LONG_TRUMP_VALUE = 3;   // each trump past the second
+const int VOID_VALUE = 4;         // with at least two trumps
+const int OFF_ACE_VALUE = 10;
+const int GUARDED_KING_VALUE = 6; // King with the Ace of its suit
+const int KING_VALUE = 3;
+
+// EFFECTS: Returns the bid score of hand, whose other features are in s
+int bid_score(CardSet hand, Suit trump, const HandStrength &s) {
+  int value = 0;
+  const CardSet trumps = hand & CardSet::trump_cards(trump);
+  for (CardSet m = trumps; !m.empty(); m.remove(m.lowest())) {
+    const Card c = m.lowest();
+    if (c.is_right_bower(trump)) {
+      value += RIGHT_BOWER_VALUE;
+    } else if (c.is_left_bower(trump)) {
+      value += LEFT_BOWER_VALUE;
+    } else {
+      value += TRUMP_VALUE[c.get_rank() - NINE];
+    }
+  }
+  value += LONG_TRUMP_VALUE * max(0, s.trumps - 2);
+  value += s.trumps >= 2 ? VOID_VALUE * s.voids : 0;
+  value += OFF_ACE_VALUE * s.off_aces;
+  for (Suit suit : SUITS) {
+    if (suit != trump && hand.contains(Card(KING, suit))) {
+      value += hand.contains(Card(ACE, suit)) ? GUARDED_KING_VALUE : KING_VALUE;
+    }
+  }
+  return value;
+}
+
+} // namespace
+
+HandStrength HandStrength_of(CardSet hand, Suit trump) {
+  assert(hand.size() == 5);
+  HandStrength s;
+  const CardSet trumps = hand & CardSet::trump_cards(trump);
+  s.trumps = trumps.size();
+  s.bowers = (trumps.contains(Card(JACK, trump)) ? 1 : 0) |
+             (trumps.contains(Card(JACK, Suit_next(trump))) ? 2 : 0);
+  s.trump_faces = (trumps & CardSet::face_or_ace_cards()).size();
+  s.off_aces = 0;
+  s.voids = 0;
+  for (Suit suit : SUITS) {
+    if (suit == trump) {
+      continue;
+    }
+    s.off_aces += hand.contains(Card(ACE, suit));
+    s.voids += (hand & CardSet::suit_cards(suit, trump)).empty();
+  }
+  s.bid_score = bid_score(hand, trump, s);
+  return s;
+}
+
+HandTable::HandTable() : entries(nullptr), map_base(nullptr), map_size(0) {
+  build();
+}
+
+HandTable::HandTable(const char *path)
+  : entries(nullptr), map_base(nullptr), map_size(0) {
+  if (!map_file(path)) {
+    build();
+  }
+}
+
+void HandTable::build() {
+  built.resize(NUM_ENTRIES);
+  entries = built.data();
+  for (uint32_t rank = 0; rank < NUM_HANDS; ++rank) {
+    const CardSet hand = Deal_hand_unrank(rank);
+    for (int trump = 0; trump < 4; ++trump) {
+      built[rank * 4 + trump] = HandStrength_of(hand, static_cast<Suit>(trump));
+    }
+  }
+}
+
+HandTable::~HandTable() {
+  if (map_base) {
+    munmap(map_base, map_size);
+  }
+}
+
+bool HandTable::map_file(const char *path) {
+  const int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat info;
+  const size_t size = sizeof(FileHeader) + NUM_ENTRIES * sizeof(HandStrength);
+  void *base = MAP_FAILED;
+  if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) == size) {
+    base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  }
+  // the mapping stays valid once the file is closed
+  close(fd);
+  if (base == MAP_FAILED) {
+    return false;
+  }
+  const FileHeader *header = static_cast<const FileHeader *>(base);
+  if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+      header->version != VERSION || header->entry_size != sizeof(HandStrength)) {
+    munmap(base, size);
+    return false;
+  }
+  map_base = base;
+  map_size = size;
+  entries = reinterpret_cast<const HandStrength *>(header + 1);
+  return true;
+}
+
+bool HandTable::save(const char *path) const {
+  FILE *out = fopen(path, "wb");
+  if (!out) {
+    return false;
+  }
+  FileHeader header;
+  memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.entry_size = sizeof(HandStrength);
+  bool ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+            fwrite(entries, sizeof(HandStrength), NUM_ENTRIES, out) == NUM_ENTRIES;
+  ok = fclose(out) == 0 && ok;
+  return ok;
+}
+
+const HandStrength & HandTable::lookup(CardSet hand, Suit trump) const {
+  return entries[Deal_hand_rank(hand) * 4 + trump];
+}
@@ -0,0 +1,88 @@
+#ifndef HANDTABLE_HPP
+#define HANDTABLE_HPP
+/* HandTable.hpp
+ *
+ * Bidding features of every five-card euchre hand, worked out ahead of
+ * time.  For each of the NUM_HANDS hands and each trump suit the table
+ * holds a HandStrength: trump count, bowers, off-suit aces, voids, and a
+ * hand-tuned bid score that sums them up.  Looking a hand up costs one
+ * Deal_hand_rank and one array read.
+ *
+ * A table is built in memory, or memory-mapped from a file written by
+ * save(), so a program that has the file pays nothing to start up and
+ * several processes share one copy of the pages.  hand_table.exe writes
+ * the file.
+ *
+ * The table is for strategies that weigh a whole hand.  The Simple bid
+ * needs only the trump faces, which two masks and a popcount count faster
+ * than a lookup can rank the hand, so SimplePlayer counts them directly.
+ */
+
+
+#include "Card.hpp"
+#include "CardSet.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// One hand with one trump suit.  The left bower counts as trump, and not
+// as a card of its own suit.
+struct HandStrength {
+  std::uint8_t trumps;        // trump cards
+  std::uint8_t bowers;        // bit 0 the right bower, bit 1 the left
+  std::uint8_t trump_faces;   // trump Jacks and up, as the Simple bid counts
+  std::uint8_t off_aces;      // Aces of other suits
+  std::uint8_t voids;         // other suits with no cards
+  std::uint8_t bid_score;     // see HandStrength_of
+};
+
+//REQUIRES hand holds five euchre cards
+//EFFECTS Returns the strength of hand with trump, worked out directly.
+//  The bid score ranks hands as trump holdings: each card gets points by
+//  what it is (the right bower 16, an off-suit Ace 10, a trump Nine 6),
+//  with a few more for long trumps and for voids to ruff with.  The
+//  points are chosen by hand and not fitted to play, so the score is not
+//  a count of tricks, and it leaves out the upcard and who holds it.
+HandStrength HandStrength_of(CardSet hand, Suit trump);
+
+class HandTable {
+public:
+  //EFFECTS Initializes a table by working out every entry
+  HandTable();
+
+  //EFFECTS Initializes a table mapped from the file at path, or worked out
+  //  as by HandTable() if the file cannot be mapped or is not a table of
+  //  this version
+  explicit HandTable(const char *path);
+
+  HandTable(const HandTable &) = delete;
+  HandTable & operator=(const HandTable &) = delete;
+
+  ~HandTable();
+
+  //EFFECTS Writes the table to the file at path, returning false if it
+  //  cannot be written
+  bool save(const char *path) const;
+
+  //EFFECTS Returns true if the table is mapped from a file
+  bool mapped() const { return map_base != nullptr; }
+
+  //REQUIRES hand holds five euchre cards
+  //EFFECTS Returns the strength of hand with trump
+  const HandStrength & lookup(CardSet hand, Suit trump) const;
+
+private:
+  std::vector<HandStrength> built;   // the entries, when not mapped
+  const HandStrength *entries;       // NUM_HANDS * 4, by hand rank, trump
+  void *map_base;                    // the mapping, or null
+  std::size_t map_size;
+
+  // EFFECTS: Works out every entry into built
+  void build();
+
+  // EFFECTS: Maps the file at path, returning false if it is not a table
+  //          of this version
+  bool map_file(const char *path);
+};
+
+#endif // HANDTABLE_HPP
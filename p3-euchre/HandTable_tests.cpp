@@ -0,0 +1,119 @@
+#include "HandTable.hpp"
+#include "Deal.hpp"
+#include "Random.hpp"
+#include "unit_test_framework.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace std;
+
+static void assert_same(const HandStrength &a, const HandStrength &b) {
+    ASSERT_EQUAL(a.trumps, b.trumps);
+    ASSERT_EQUAL(a.bowers, b.bowers);
+    ASSERT_EQUAL(a.trump_faces, b.trump_faces);
+    ASSERT_EQUAL(a.off_aces, b.off_aces);
+    ASSERT_EQUAL(a.voids, b.voids);
+    ASSERT_EQUAL(a.bid_score, b.bid_score);
+}
+
+static CardSet make_hand(const Card *cards) {
+    CardSet hand;
+    for (int i = 0; i < 5; ++i) {
+        hand.add(cards[i]);
+    }
+    return hand;
+}
+
+TEST(test_hand_strength_features) {
+    const Card cards[] = {Card(JACK, SPADES), Card(JACK, CLUBS), Card(ACE, SPADES),
+                          Card(ACE, HEARTS), Card(NINE, DIAMONDS)};
+    const CardSet hand = make_hand(cards);
+    HandStrength spades = HandStrength_of(hand, SPADES);
+    ASSERT_EQUAL(spades.trumps, 3);
+    ASSERT_EQUAL(spades.bowers, 3);
+    ASSERT_EQUAL(spades.trump_faces, 3);
+    ASSERT_EQUAL(spades.off_aces, 1);
+    // the Jack of Clubs is a spade, so Clubs is void
+    ASSERT_EQUAL(spades.voids, 1);
+
+    HandStrength hearts = HandStrength_of(hand, HEARTS);
+    ASSERT_EQUAL(hearts.trumps, 1);
+    ASSERT_EQUAL(hearts.bowers, 0);
+    ASSERT_EQUAL(hearts.trump_faces, 1);
+    ASSERT_EQUAL(hearts.off_aces, 1);
+    ASSERT_EQUAL(hearts.voids, 0);
+    ASSERT_TRUE(hearts.bid_score < spades.bid_score);
+}
+
+// The bid score adds up the cards' points
+TEST(test_hand_strength_bid_score) {
+    // right bower, left bower, Ace of trump, one trump past the second,
+    // a void in diamonds to ruff with, and Aces of two other suits
+    const Card best[] = {Card(JACK, HEARTS), Card(JACK, DIAMONDS), Card(ACE, HEARTS),
+                         Card(ACE, SPADES), Card(ACE, CLUBS)};
+    ASSERT_EQUAL(HandStrength_of(make_hand(best), HEARTS).bid_score,
+                 16 + 14 + 12 + 3 + 4 + 10 + 10);
+
+    // no trump: only the off-suit Ace and the King it guards score
+    const Card weak[] = {Card(NINE, SPADES), Card(TEN, SPADES), Card(ACE, CLUBS),
+                         Card(KING, CLUBS), Card(NINE, DIAMONDS)};
+    ASSERT_EQUAL(HandStrength_of(make_hand(weak), HEARTS).bid_score, 10 + 6);
+
+    // the same hand scores higher with the suit it is long in as trump
+    ASSERT_TRUE(HandStrength_of(make_hand(weak), SPADES).bid_score
+                > HandStrength_of(make_hand(weak), HEARTS).bid_score);
+}
+
+// Every entry of the built table is the strength worked out directly
+TEST(test_table_lookup) {
+    HandTable table;
+    ASSERT_FALSE(table.mapped());
+    for (uint32_t rank = 0; rank < NUM_HANDS; rank += 7) {
+        const CardSet hand = Deal_hand_unrank(rank);
+        for (int trump = 0; trump < 4; ++trump) {
+            const Suit suit = static_cast<Suit>(trump);
+            assert_same(table.lookup(hand, suit), HandStrength_of(hand, suit));
+        }
+    }
+}
+
+// A saved table maps back with the same entries
+TEST(test_table_save_and_map) {
+    HandTable built;
+    ASSERT_TRUE(built.save("HandTable_test.bin"));
+    HandTable mapped("HandTable_test.bin");
+    ASSERT_TRUE(mapped.mapped());
+    Rng rng(5);
+    for (int i = 0; i < 2000; ++i) {
+        const CardSet hand = Deal_hand_unrank(rng.below(NUM_HANDS));
+        const Suit trump = static_cast<Suit>(i % 4);
+        assert_same(mapped.lookup(hand, trump), built.lookup(hand, trump));
+    }
+    remove("HandTable_test.bin");
+}
+
+// A missing, short or foreign file leaves a table built in memory
+TEST(test_table_bad_files) {
+    HandTable missing("HandTable_missing.bin");
+    ASSERT_FALSE(missing.mapped());
+
+    ofstream("HandTable_short.bin") << "EUCHREHT";
+    HandTable short_file("HandTable_short.bin");
+    ASSERT_FALSE(short_file.mapped());
+    remove("HandTable_short.bin");
+
+    HandTable().save("HandTable_foreign.bin");
+    {
+        fstream file("HandTable_foreign.bin", ios::in | ios::out | ios::binary);
+        file.write("NOTATABL", 8);
+    }
+    HandTable foreign("HandTable_foreign.bin");
+    ASSERT_FALSE(foreign.mapped());
+    remove("HandTable_foreign.bin");
+
+    const CardSet hand = Deal_hand_unrank(1234);
+    assert_same(foreign.lookup(hand, CLUBS), HandStrength_of(hand, CLUBS));
+}
+
+TEST_MAIN()
@@ -0,0 +1,61 @@
+#include "Hand.hpp"
+#include "Card.hpp"
+#include "unit_test_framework.hpp"
+
+using namespace std;
+
+TEST(test_hand_push_back) {
+    Hand hand;
+    ASSERT_TRUE(hand.empty());
+    hand.push_back(Card(ACE, SPADES));
+    hand.push_back(Card(NINE, HEARTS));
+    ASSERT_EQUAL(hand.size(), 2);
+    ASSERT_EQUAL(hand[0], Card(ACE, SPADES));
+    ASSERT_EQUAL(hand[1], Card(NINE, HEARTS));
+}
+
+TEST(test_hand_insert_sorted) {
+    Hand hand;
+    hand.insert_sorted(Card(KING, CLUBS));
+    hand.insert_sorted(Card(NINE, DIAMONDS));
+    hand.insert_sorted(Card(ACE, SPADES));
+    hand.insert_sorted(Card(KING, SPADES));
+    hand.insert_sorted(Card(TEN, HEARTS));
+    hand.insert_sorted(Card(JACK, HEARTS));
+    ASSERT_EQUAL(hand.size(), Hand::CAPACITY);
+    for (int i = 0; i + 1 < hand.size(); ++i) {
+        ASSERT_TRUE(hand[i] < hand[i + 1]);
+    }
+    ASSERT_EQUAL(hand[0], Card(NINE, DIAMONDS));
+    ASSERT_EQUAL(hand[5], Card(ACE, SPADES));
+}
+
+TEST(test_hand_remove_at_keeps_order) {
+    Hand hand;
+    hand.push_back(Card(NINE, SPADES));
+    hand.push_back(Card(TEN, SPADES));
+    hand.push_back(Card(JACK, SPADES));
+    ASSERT_EQUAL(hand.remove_at(0), Card(NINE, SPADES));
+    ASSERT_EQUAL(hand.size(), 2);
+    ASSERT_EQUAL(hand[0], Card(TEN, SPADES));
+    ASSERT_EQUAL(hand[1], Card(JACK, SPADES));
+}
+
+TEST(test_hand_swap_remove) {
+    Hand hand;
+    hand.push_back(Card(NINE, SPADES));
+    hand.push_back(Card(TEN, SPADES));
+    hand.push_back(Card(JACK, SPADES));
+    ASSERT_EQUAL(hand.swap_remove(0), Card(NINE, SPADES));
+    ASSERT_EQUAL(hand.size(), 2);
+    ASSERT_EQUAL(hand[0], Card(JACK, SPADES));
+    ASSERT_EQUAL(hand[1], Card(TEN, SPADES));
+    int n = 0;
+    for (const Card &c : hand) {
+        ASSERT_EQUAL(c.get_suit(), SPADES);
+        ++n;
+    }
+    ASSERT_EQUAL(n, 2);
+}
+
+TEST_MAIN()
@@ -0,0 +1,288 @@
+#include "ISMCTSPlayer.hpp"
+#include "DoubleDummy.hpp"
+#include <cassert>
+#include <cmath>
+
+using namespace std;
+
+namespace {
+
+// weight of the exploration term in the UCB formula
+const double EXPLORATION = 0.7;
+
+inline uint64_t bit(int id) {
+  return uint64_t(1) << id;
+}
+
+// EFFECTS: Returns the effective suit of card id when trump is trump
+inline int suit_of(int id, Suit trump) {
+  return Card_from_id(static_cast<CardId>(id)).get_suit(trump);
+}
+
+// EFFECTS: Returns a card of set chosen uniformly at random
+int random_card(uint64_t set, Rng &rng) {
+  for (uint32_t skip = rng.below(CardSet::popcount(set)); skip > 0; --skip) {
+    set &= set - 1;
+  }
+  return CardSet::count_trailing_zeros(set);
+}
+
+// One deal played out from the current position, all hands visible
+struct World {
+  uint64_t hands[4];
+  Suit trump;
+  int leader;      // player who led the current trick
+  int played;      // cards played to it so far
+  int led;         // effective suit led
+  int winner;      // player winning it so far
+  int strength;    // CARD_ORDER strength of the winning card
+  int tricks[2];   // tricks taken by each team
+
+  // EFFECTS: Sets up the world from position, with tricks already taken
+  void start(const DoubleDummyPosition &position, int team0, int team1) {
+    for (int seat = 0; seat < 4; ++seat) {
+      hands[seat] = position.hands[seat].mask();
+    }
+    trump = position.trump;
+    leader = position.leader;
+    played = 0;
+    tricks[0] = team0;
+    tricks[1] = team1;
+    for (int pos = 0; pos < position.played; ++pos) {
+      play(Card_id(position.trick[pos]));
+    }
+  }
+
+  int mover() const { return (leader + played) % 4; }
+
+  bool over() const { return played == 0 && hands[leader] == 0; }
+
+  // EFFECTS: Returns the cards the player to move may play
+  uint64_t legal() const {
+    const uint64_t hand = hands[mover()];
+    if (played == 0) {
+      return hand;
+    }
+    const uint64_t follow =
+      hand & CardSet::suit_cards(static_cast<Suit>(led), trump).mask();
+    return (follow != 0) ? follow : hand;
+  }
+
+  // EFFECTS: Plays card id for the player to move
+  void play(int id) {
+    const int seat = mover();
+    if (played == 0) {
+      led = suit_of(id, trump);
+      strength = -1;
+    }
+    const int s = CARD_ORDER.value[trump][led][id >> 2][id & 3];
+    if (s > strength) {
+      strength = s;
+      winner = seat;
+    }
+    hands[seat] &= ~bit(id);
+    if (++played == 4) {
+      ++tricks[winner % 2];
+      leader = winner;
+      played = 0;
+    }
+  }
+};
+
+} // namespace
+
+struct ISMCTSPlayer::Descent {
+  World world;
+  Node *node;   // last node walked through, the one added if any
+};
+
+ISMCTSPlayer::ISMCTSPlayer(const string &name_in, const ISMCTSConfig &config_in)
+  : SearchPlayer(name_in, config_in.threads), config(config_in),
+    trees(config_in.threads) {
+  assert(config.iterations > 0 && config.threads > 0);
+}
+
+void ISMCTSPlayer::new_hand(int seat_in, int dealer_in) {
+  SearchPlayer::new_hand(seat_in, dealer_in);
+  for (Tree &tree : trees) {
+    tree.nodes.reset();
+    tree.root = nullptr;
+  }
+}
+
+void ISMCTSPlayer::trump_made(int maker_in, Suit trump_in,
+                              const Card &upcard_in, bool upcard_taken_in) {
+  SearchPlayer::trump_made(maker_in, trump_in, upcard_in, upcard_taken_in);
+  for (Tree &tree : trees) {
+    tree.root = tree.nodes.make();
+  }
+}
+
+void ISMCTSPlayer::card_played(int seat_in, const Card &card) {
+  SearchPlayer::card_played(seat_in, card);
+  for (Tree &tree : trees) {
+    if (tree.root) {
+      // keep the searches below the card just played
+      tree.root = child(tree, tree.root, seat_in, Card_id(card));
+    }
+  }
+}
+
+uint64_t ISMCTSPlayer::iterations_run() const {
+  uint64_t total = 0;
+  for (const Tree &tree : trees) {
+    total += tree.iterations;
+  }
+  return total;
+}
+
+uint32_t ISMCTSPlayer::root_visits() const {
+  uint32_t total = 0;
+  for (const Tree &tree : trees) {
+    total += tree.root ? tree.root->visits : 0;
+  }
+  return total;
+}
+
+size_t ISMCTSPlayer::tree_size() const {
+  size_t total = 0;
+  for (const Tree &tree : trees) {
+    total += tree.nodes.size();
+  }
+  return total;
+}
+
+Card ISMCTSPlayer::choose(CardSet legal) {
+  ++decisions;
+  const uint64_t deadline = (config.time_limit_ms > 0)
+    ? now_ns() + static_cast<uint64_t>(config.time_limit_ms * 1e6) : 0;
+  const int threads = get_threads();
+  for (int t = 0; t < threads; ++t) {
+    Tree &tree = trees[t];
+    if (!tree.root) {
+      tree.root = tree.nodes.make();
+    }
+    tree.rng.reseed(Rng::game_seed(Rng::game_seed(config.seed, get_seat()),
+                                   decisions * threads + t));
+  }
+  run_threads([this, deadline](int t) { search(trees[t], t, deadline); });
+
+  // most searched over all trees wins; ties go to the lower card
+  long visits[NUM_CARDS] = {};
+  for (const Tree &tree : trees) {
+    for (Node *c = tree.root->first_child; c; c = c->next_sibling) {
+      visits[c->card] += c->visits;
+    }
+  }
+  Card best = legal.lowest(get_trump());
+  for (uint64_t m = legal.mask(); m != 0; m &= m - 1) {
+    const Card card = CardSet::card_at(CardSet::count_trailing_zeros(m));
+    const long diff = visits[Card_id(card)] - visits[Card_id(best)];
+    if (diff > 0 || (diff == 0 && Card_less(card, best, get_trump()))) {
+      best = card;
+    }
+  }
+  return best;
+}
+
+void ISMCTSPlayer::search(Tree &tree, int first, uint64_t deadline_ns) {
+  const int step = get_threads();
+  for (int i = first; i < config.iterations; i += step) {
+    // the first search is always run, so there is an answer
+    if (deadline_ns != 0 && i != 0 && now_ns() > deadline_ns) {
+      break;
+    }
+    iterate(tree);
+  }
+}
+
+void ISMCTSPlayer::iterate(Tree &tree) {
+  DoubleDummyPosition position;
+  if (!deal_hidden(tree.rng, position)) {
+    return;
+  }
+  Descent descent;
+  descent.world.start(position, get_tricks_won(0), get_tricks_won(1));
+  select(tree, descent);
+
+  // play the rest of the hand out at random
+  World &world = descent.world;
+  while (!world.over()) {
+    world.play(random_card(world.legal(), tree.rng));
+  }
+  const int makers = get_maker() % 2;
+  const int points = hand_score(world.tricks[makers], true);
+  double reward[2];
+  reward[makers] = (points + 2) / 4.0;
+  reward[1 - makers] = 1 - reward[makers];
+
+  // the visits were counted on the way down
+  for (Node *n = descent.node; n != tree.root; n = n->parent) {
+    n->reward += reward[n->seat % 2];
+  }
+  ++tree.iterations;
+}
+
+void ISMCTSPlayer::select(Tree &tree, Descent &descent) {
+  World &world = descent.world;
+  Node *node = tree.root;
+  ++node->visits;
+  while (!world.over()) {
+    const uint64_t legal = world.legal();
+    uint64_t untried = legal;
+    Node *best = nullptr;
+    double best_score = -1;
+    for (Node *c = node->first_child; c; c = c->next_sibling) {
+      if ((legal & bit(c->card)) == 0) {
+        continue;
+      }
+      untried &= ~bit(c->card);
+      ++c->available;
+      const double score = c->reward / c->visits +
+        EXPLORATION * sqrt(log(c->available) / c->visits);
+      if (score > best_score) {
+        best = c;
+        best_score = score;
+      }
+    }
+    if (untried != 0) {
+      // grow the tree by one node and stop
+      const int id = random_card(untried, tree.rng);
+      node = child(tree, node, world.mover(), static_cast<CardId>(id));
+      ++node->available;
+      ++node->visits;
+      world.play(id);
+      break;
+    }
+    node = best;
+    ++node->visits;
+    world.play(node->card);
+  }
+  descent.node = node;
+}
+
+ISMCTSPlayer::Node * ISMCTSPlayer::child(Tree &tree, Node *node, int seat,
+                                         CardId card) {
+  for (Node *c = node->first_child; c; c = c->next_sibling) {
+    if (c->card == card) {
+      return c;
+    }
+  }
+  Node *c = tree.nodes.make();
+  c->parent = node;
+  c->next_sibling = node->first_child;
+  node->first_child = c;
+  c->card = card;
+  c->seat = static_cast<uint8_t>(seat);
+  return c;
+}
+
+bool ISMCTS_parse_strategy(const string &strategy, ISMCTSConfig &config) {
+  const string prefix = "ISMCTS";
+  if (strategy.compare(0, prefix.size(), prefix) != 0) {
+    return false;
+  }
+  return parse_search_budget(strategy.c_str() + prefix.size(),
+                             config.iterations, config.time_limit_ms,
+                             config.threads);
+}
@@ -0,0 +1,130 @@
+#ifndef ISMCTSPLAYER_HPP
+#define ISMCTSPLAYER_HPP
+/* ISMCTSPlayer.hpp
+ *
+ * The "ISMCTS" computer strategy: information-set Monte Carlo tree search.
+ * Each iteration deals the unseen cards at random (see SearchPlayer),
+ * walks a tree of card plays from the current position choosing by UCB
+ * among the cards legal in that deal, adds one new node, plays the hand
+ * out at random and scores it.  The player plays the card searched most.
+ * Bidding follows the Simple strategy.
+ *
+ * One tree serves the whole hand.  As cards are played the root moves
+ * down to the matching child, so what was learned about the rest of the
+ * hand carries over to the next decision.  Nodes come from an arena that
+ * is emptied when the next hand starts.
+ *
+ * With more than one thread, each thread grows a tree of its own from its
+ * own random deals, so the threads share no locks ("root parallel"
+ * search).  The trees move down together as cards are played, and a
+ * decision adds up the visits to each card at the roots of all of them.
+ * The threads are the player's WorkerPool, kept from one decision to the
+ * next.
+ *
+ * Root parallelism takes the place of the usual shared tree with virtual
+ * loss.  Virtual loss keeps threads that share one tree from all walking
+ * the same path, but every iteration would then update each node on its
+ * path from several threads, and expanding a node would need a lock.  An
+ * iteration here is only a few microseconds of random play-out, so that
+ * synchronization costs a large share of it; a shared tree under one lock
+ * gained nothing from more threads.  Separate trees need no
+ * synchronization at all, already diverge because each thread deals its
+ * own hidden cards, and keep a search reproducible for a given seed and
+ * thread count.
+ */
+
+
+#include "SearchPlayer.hpp"
+#include "Arena.hpp"
+#include "CardSet.hpp"
+#include "Random.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct ISMCTSConfig {
+  int iterations = 1000;      // tree searches per decision
+  double time_limit_ms = 0;   // stop searching after this long; 0 for none
+  int threads = 1;            // threads searching in parallel, each with
+                              // its own tree
+  std::uint64_t seed = 0;     // search is reproducible for a given seed
+                              // and thread count, with no time limit
+};
+
+class ISMCTSPlayer final : public SearchPlayer {
+public:
+  //REQUIRES config.iterations > 0 and config.threads > 0
+  //EFFECTS Initializes a player with the given name and search budget
+  ISMCTSPlayer(const std::string &name_in,
+               const ISMCTSConfig &config_in = ISMCTSConfig());
+
+  void new_hand(int seat, int dealer) override;
+  void trump_made(int maker, Suit trump, const Card &upcard,
+                  bool upcard_taken) override;
+  void card_played(int seat, const Card &card) override;
+
+  //EFFECTS Returns the number of tree searches run since construction
+  std::uint64_t iterations_run() const;
+
+  //EFFECTS Returns the number of searches that have passed through the
+  //  current roots, including ones from earlier decisions this hand
+  std::uint32_t root_visits() const;
+
+  //EFFECTS Returns the number of tree nodes made this hand, in all trees
+  std::size_t tree_size() const;
+
+protected:
+  Card choose(CardSet legal) override;
+
+private:
+  // A card play, and the statistics of the searches that made it
+  struct Node {
+    Node *parent;
+    Node *first_child;
+    Node *next_sibling;
+    double reward;             // summed results for the team that played
+    std::uint32_t visits;      // searches through here, finished or not
+    std::uint32_t available;   // times card was legal at the parent
+    CardId card;
+    std::uint8_t seat;         // player who played card
+  };
+
+  // One thread's search: only that thread touches it during a decision
+  struct Tree {
+    Arena<Node> nodes;
+    Node *root = nullptr;
+    Rng rng;
+    std::uint64_t iterations = 0;  // searches run since construction
+  };
+
+  // One search iteration's walk down the tree
+  struct Descent;
+
+  ISMCTSConfig config;
+  std::vector<Tree> trees;     // one per thread
+  std::uint64_t decisions = 0;
+
+  // EFFECTS: Runs iterations first, first + threads, ... below the budget
+  //          on tree
+  void search(Tree &tree, int first, std::uint64_t deadline_ns);
+
+  // EFFECTS: Runs one search of tree on a random deal
+  void iterate(Tree &tree);
+
+  // EFFECTS: Walks down from the root of tree, playing the cards chosen
+  //          in descent's deal, and adds a node for one untried card
+  void select(Tree &tree, Descent &descent);
+
+  // EFFECTS: Returns the child of node in tree that plays card as seat,
+  //          making one if there is none
+  static Node * child(Tree &tree, Node *node, int seat, CardId card);
+};
+
+//EFFECTS If strategy is "ISMCTS", optionally followed by ":ITERATIONS",
+//  ":ITERATIONS:MILLISECONDS" or ":ITERATIONS:MILLISECONDS:THREADS", sets
+//  the matching fields of config and returns true.  Otherwise returns
+//  false.
+bool ISMCTS_parse_strategy(const std::string &strategy, ISMCTSConfig &config);
+
+#endif // ISMCTSPLAYER_HPP
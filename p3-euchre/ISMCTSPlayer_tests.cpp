@@ -0,0 +1,139 @@
+#include "ISMCTSPlayer.hpp"
+#include "Game.hpp"
+#include "Pack.hpp"
+#include "Player.hpp"
+#include "unit_test_framework.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Plays one game of ISMCTS players in seats 0 and 2 against Simple
+// players, with a random shuffle seeded by seed
+static GameResult play_against_simple(uint64_t seed, const ISMCTSConfig &config) {
+    ISMCTSPlayer north("North", config);
+    ISMCTSPlayer south("South", config);
+    vector<Player*> players = {&north, Player_factory("East", "Simple"),
+                               &south, Player_factory("West", "Simple")};
+    EuchreGame game(Pack(), false, 10, players, nullptr);
+    game.use_random_shuffle(seed);
+    GameResult result = game.startGame();
+    delete players[1];
+    delete players[3];
+    ASSERT_TRUE(north.iterations_run() > 0);
+    return result;
+}
+
+// Deals a hand to p in seat 0 with seat 3 dealing, and makes spades trump
+static void start_hand(ISMCTSPlayer &p) {
+    p.new_hand(0, 3);
+    const Card cards[] = {Card(JACK, SPADES), Card(ACE, SPADES), Card(NINE, HEARTS),
+                          Card(KING, CLUBS), Card(TEN, DIAMONDS)};
+    for (const Card &c : cards) {
+        p.add_card(c);
+    }
+    p.trump_made(1, SPADES, Card(QUEEN, SPADES), true);
+}
+
+TEST(test_ismcts_parse_strategy) {
+    ISMCTSConfig config;
+    ASSERT_TRUE(ISMCTS_parse_strategy("ISMCTS", config));
+    ASSERT_EQUAL(config.iterations, ISMCTSConfig().iterations);
+    ASSERT_TRUE(ISMCTS_parse_strategy("ISMCTS:200:1.5:4", config));
+    ASSERT_EQUAL(config.iterations, 200);
+    ASSERT_ALMOST_EQUAL(config.time_limit_ms, 1.5, 1e-12);
+    ASSERT_EQUAL(config.threads, 4);
+
+    const char *bad[] = {"MonteCarlo", "ISMCTS2", "ISMCTS:0", "ISMCTS:5:1:0"};
+    for (const char *strategy : bad) {
+        ISMCTSConfig unchanged;
+        ASSERT_FALSE(ISMCTS_parse_strategy(strategy, unchanged));
+        ASSERT_EQUAL(unchanged.iterations, ISMCTSConfig().iterations);
+    }
+
+    Player *p = Player_factory("Ada", "ISMCTS:50");
+    ASSERT_EQUAL(p->get_name(), "Ada");
+    delete p;
+}
+
+// The tree built for one decision carries over to the next one, and is
+// emptied when a new hand starts
+TEST(test_ismcts_tree_reuse) {
+    ISMCTSConfig config;
+    config.iterations = 300;
+    ISMCTSPlayer p("Ada", config);
+    start_hand(p);
+    Card led = p.lead_card(SPADES);
+    ASSERT_EQUAL(p.iterations_run(), 300u);
+    size_t size_after_lead = p.tree_size();
+    ASSERT_TRUE(size_after_lead > 300);
+
+    p.card_played(0, led);
+    ASSERT_TRUE(p.root_visits() > 0);
+    uint32_t visits = p.root_visits();
+    const Card follow[] = {Card(NINE, SPADES), Card(TEN, SPADES), Card(KING, SPADES)};
+    for (int seat = 1; seat < 4; ++seat) {
+        p.card_played(seat, follow[seat - 1]);
+        ASSERT_TRUE(p.root_visits() <= visits);
+        visits = p.root_visits();
+    }
+    // moving the root frees nothing; the arena only empties between hands
+    ASSERT_TRUE(p.tree_size() >= size_after_lead);
+
+    start_hand(p);
+    ASSERT_EQUAL(p.tree_size(), 1u);
+    ASSERT_EQUAL(p.root_visits(), 0u);
+}
+
+// Full games finish and are reproducible from the seeds
+TEST(test_ismcts_games) {
+    ISMCTSConfig config;
+    config.iterations = 200;
+    config.seed = 3;
+    for (uint64_t seed = 0; seed < 3; ++seed) {
+        GameResult first = play_against_simple(seed, config);
+        GameResult again = play_against_simple(seed, config);
+        ASSERT_EQUAL(first.points[0], again.points[0]);
+        ASSERT_EQUAL(first.hands_played, again.hands_played);
+    }
+}
+
+// Each thread searches a tree of its own, every search is counted, and
+// the trees follow the play
+TEST(test_ismcts_threads) {
+    ISMCTSConfig config;
+    config.iterations = 400;
+    config.threads = 3;
+    ISMCTSPlayer p("Ada", config);
+    start_hand(p);
+    ASSERT_EQUAL(p.tree_size(), 3u);
+    Card led = p.lead_card(SPADES);
+    ASSERT_EQUAL(p.iterations_run(), 400u);
+    ASSERT_EQUAL(p.root_visits(), 400u);
+    p.card_played(0, led);
+    ASSERT_TRUE(p.root_visits() > 0 && p.root_visits() <= 400u);
+
+    // with no time limit the split of the searches is fixed, so threaded
+    // games are reproducible too
+    GameResult result = play_against_simple(9, config);
+    ASSERT_TRUE(result.points[0] >= 10 || result.points[1] >= 10);
+    GameResult again = play_against_simple(9, config);
+    ASSERT_EQUAL(result.points[0], again.points[0]);
+    ASSERT_EQUAL(result.hands_played, again.hands_played);
+}
+
+// Searching beats the Simple strategy over a run of games
+TEST(test_ismcts_beats_simple) {
+    ISMCTSConfig config;
+    config.iterations = 500;
+    int points[2] = {0, 0};
+    for (uint64_t seed = 200; seed < 230; ++seed) {
+        GameResult result = play_against_simple(seed, config);
+        points[0] += result.points[0];
+        points[1] += result.points[1];
+    }
+    ASSERT_TRUE(points[0] > points[1]);
+}
+
+TEST_MAIN()
@@ -0,0 +1,147 @@
+#include "Instrument.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <vector>
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+const char *PHASE_NAMES[NUM_PHASES] = {
+  "shuffle", "deal", "bid", "trick", "score", "output"
+};
+
+const char *CALL_NAMES[NUM_CALLS] = {
+  "make_trump", "add_and_discard", "lead_card", "play_card"
+};
+
+string class_name(const type_info &type) {
+#if defined(__GNUC__)
+  int status = 0;
+  char *name = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+  if (status == 0) {
+    const string result = name;
+    free(name);
+    return result;
+  }
+#endif
+  return type.name();
+}
+
+void add_to(InstrumentCount &total, const InstrumentCount &count) {
+  total.calls += count.calls;
+  total.ticks += count.ticks;
+}
+
+// EFFECTS: Adds counters to summary
+void add_counters(InstrumentSummary &summary, const InstrumentCounters &counters) {
+  for (int phase = 0; phase < NUM_PHASES; ++phase) {
+    add_to(summary.phases[phase], counters.phases[phase].read());
+  }
+  for (int slot = 0; slot < InstrumentCounters::MAX_STRATEGIES; ++slot) {
+    const type_info *strategy = counters.strategies[slot].load();
+    if (!strategy) {
+      break;
+    }
+    auto &calls = summary.strategies[class_name(*strategy)];
+    for (int call = 0; call < NUM_CALLS; ++call) {
+      add_to(calls[call], counters.calls[slot][call].read());
+    }
+  }
+}
+
+// Every thread's counters, and the totals of threads that have finished
+struct Registry {
+  mutex lock;
+  vector<const InstrumentCounters *> live;
+  InstrumentSummary retired;
+};
+
+Registry & registry() {
+  // never destroyed, so threads may finish after main returns
+  static Registry *shared = new Registry;
+  return *shared;
+}
+
+// A thread's counters, registered for as long as the thread runs
+struct ThreadCounters {
+  InstrumentCounters counters;
+
+  ThreadCounters() {
+    lock_guard<mutex> guard(registry().lock);
+    registry().live.push_back(&counters);
+  }
+
+  ~ThreadCounters() {
+    Registry &shared = registry();
+    lock_guard<mutex> guard(shared.lock);
+    add_counters(shared.retired, counters);
+    shared.live.erase(find(shared.live.begin(), shared.live.end(), &counters));
+  }
+};
+
+void print_row(ostream &os, const string &name, const InstrumentCount &count) {
+  const double per_call = count.calls ? double(count.ticks) / count.calls : 0;
+  os << "  " << left << setw(20) << name << right << setw(14) << count.calls
+     << setw(18) << count.ticks << setw(14) << per_call << '\n';
+}
+
+} // namespace
+
+InstrumentCounter * InstrumentCounters::strategy_calls(const type_info &strategy) {
+  int slot = 0;
+  for (; slot < MAX_STRATEGIES - 1; ++slot) {
+    const type_info *seen = strategies[slot].load(memory_order_relaxed);
+    if (seen == &strategy || (seen && *seen == strategy)) {
+      return calls[slot];
+    }
+    if (!seen) {
+      break;
+    }
+  }
+  // a new strategy, or one too many that shares the last slot
+  if (!strategies[slot].load(memory_order_relaxed)) {
+    strategies[slot].store(&strategy, memory_order_release);
+  }
+  return calls[slot];
+}
+
+InstrumentCounters & Instrument_counters() {
+  thread_local ThreadCounters mine;
+  return mine.counters;
+}
+
+InstrumentSummary Instrument_summary() {
+  Registry &shared = registry();
+  lock_guard<mutex> guard(shared.lock);
+  InstrumentSummary summary = shared.retired;
+  for (const InstrumentCounters *counters : shared.live) {
+    add_counters(summary, *counters);
+  }
+  return summary;
+}
+
+void Instrument_print(ostream &os, const InstrumentSummary &summary) {
+  const ios::fmtflags flags = os.flags();
+  const streamsize precision = os.precision();
+  os << left << setw(22) << "phase" << right << setw(14) << "calls"
+     << setw(18) << "ticks" << setw(14) << "ticks/call" << '\n'
+     << fixed << setprecision(1);
+  for (int phase = 0; phase < NUM_PHASES; ++phase) {
+    print_row(os, PHASE_NAMES[phase], summary.phases[phase]);
+  }
+  for (const auto &strategy : summary.strategies) {
+    os << strategy.first << '\n';
+    for (int call = 0; call < NUM_CALLS; ++call) {
+      print_row(os, CALL_NAMES[call], strategy.second[call]);
+    }
+  }
+  os.flags(flags);
+  os.precision(precision);
+}
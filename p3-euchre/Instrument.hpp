@@ -0,0 +1,163 @@
+#ifndef INSTRUMENT_HPP
+#define INSTRUMENT_HPP
+/* Instrument.hpp
+ *
+ * Counters that show where a game spends its time.  Built with
+ * -DEUCHRE_INSTRUMENT, the game engine counts calls and clock ticks for
+ * each phase of a hand and for each call into a player, by strategy.
+ * Without it the INSTRUMENT_ macros expand to nothing and the game pays
+ * nothing.
+ *
+ * Each thread counts into its own counters, so threads running games in
+ * parallel never share a cache line.  Instrument_summary adds up every
+ * thread's counters, including those of threads that have finished.
+ * Nothing is printed unless asked for: euchre_instrumented.exe and
+ * tournament_instrumented.exe print the summary to standard error once
+ * their games are over.
+ *
+ * Ticks come from the time stamp counter where the CPU has one, and are
+ * nanoseconds of std::chrono::steady_clock elsewhere.  Phases include
+ * the calls made inside them: bidding includes make_trump, and tricks
+ * include lead_card and play_card.  Output counts only handing transcript
+ * text to its stream; formatting it is part of the phase that writes it.
+ */
+
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <typeinfo>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+enum InstrumentPhase {
+  PHASE_SHUFFLE,
+  PHASE_DEAL,
+  PHASE_BID,
+  PHASE_TRICK,
+  PHASE_SCORE,
+  PHASE_OUTPUT,
+  NUM_PHASES
+};
+
+// The calls into a player that return a decision
+enum InstrumentCall {
+  CALL_MAKE_TRUMP,
+  CALL_ADD_AND_DISCARD,
+  CALL_LEAD_CARD,
+  CALL_PLAY_CARD,
+  NUM_CALLS
+};
+
+// A count of calls and the ticks they took
+struct InstrumentCount {
+  std::uint64_t calls = 0;
+  std::uint64_t ticks = 0;
+};
+
+// The same, counted by one thread and readable by any.  Only the owning
+// thread writes, so relaxed loads and stores suffice and no update needs
+// a locked instruction.
+class InstrumentCounter {
+public:
+  void add(std::uint64_t ticks_in) {
+    calls.store(calls.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+    ticks.store(ticks.load(std::memory_order_relaxed) + ticks_in,
+                std::memory_order_relaxed);
+  }
+
+  InstrumentCount read() const {
+    InstrumentCount count;
+    count.calls = calls.load(std::memory_order_relaxed);
+    count.ticks = ticks.load(std::memory_order_relaxed);
+    return count;
+  }
+
+private:
+  std::atomic<std::uint64_t> calls{0};
+  std::atomic<std::uint64_t> ticks{0};
+};
+
+// One thread's counters
+struct InstrumentCounters {
+  static const int MAX_STRATEGIES = 8;  // more share the last slot
+
+  InstrumentCounter phases[NUM_PHASES];
+  // the dynamic type of the player behind each slot of calls
+  std::atomic<const std::type_info *> strategies[MAX_STRATEGIES] = {};
+  InstrumentCounter calls[MAX_STRATEGIES][NUM_CALLS];
+
+  //EFFECTS Returns the counters for calls into players of type strategy
+  InstrumentCounter * strategy_calls(const std::type_info &strategy);
+};
+
+// Totals across threads.  Strategies are named by class.
+struct InstrumentSummary {
+  std::array<InstrumentCount, NUM_PHASES> phases{};
+  std::map<std::string, std::array<InstrumentCount, NUM_CALLS>> strategies;
+};
+
+//EFFECTS Returns the counters of the calling thread
+InstrumentCounters & Instrument_counters();
+
+//EFFECTS Returns the totals of every thread's counters so far
+InstrumentSummary Instrument_summary();
+
+//EFFECTS Prints summary as a table of calls, ticks, and ticks per call,
+//  leaving the format flags of os as they were
+void Instrument_print(std::ostream &os, const InstrumentSummary &summary);
+
+//EFFECTS Returns the current tick
+inline std::uint64_t Instrument_ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+// Adds the ticks from its construction to its destruction to a counter
+class InstrumentScope {
+public:
+  explicit InstrumentScope(InstrumentCounter &counter_in)
+    : counter(counter_in), start(Instrument_ticks()) {}
+
+  ~InstrumentScope() {
+    counter.add(Instrument_ticks() - start);
+  }
+
+  InstrumentScope(const InstrumentScope &) = delete;
+  InstrumentScope & operator=(const InstrumentScope &) = delete;
+
+private:
+  InstrumentCounter &counter;
+  std::uint64_t start;
+};
+
+//EFFECTS Evaluates call, a call into player, counting it as kind
+template <typename P, typename F>
+inline auto Instrument_call(const P &player, InstrumentCall kind, F call) {
+  InstrumentScope scope(Instrument_counters().strategy_calls(typeid(player))[kind]);
+  return call();
+}
+
+#ifdef EUCHRE_INSTRUMENT
+// Times the rest of the enclosing block as phase
+#define INSTRUMENT_PHASE(phase) \
+  InstrumentScope instrument_phase(Instrument_counters().phases[phase])
+// Evaluates expr, a call into *player, timing it as call
+#define INSTRUMENT_CALL(player, call, expr) \
+  Instrument_call(*(player), call, [&]() { return expr; })
+#else
+#define INSTRUMENT_PHASE(phase) static_cast<void>(0)
+#define INSTRUMENT_CALL(player, call, expr) (expr)
+#endif
+
+#endif // INSTRUMENT_HPP
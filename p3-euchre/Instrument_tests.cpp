@@ -0,0 +1,145 @@
+#include "Instrument.hpp"
+#include "Game.hpp"
+#include "Pack.hpp"
+#include "SimplePlayer.hpp"
+#include "unit_test_framework.hpp"
+
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Plays as a SimplePlayer under another class name
+class Wrapped : public Player {
+public:
+    Wrapped() : inner("Wrapped") {}
+
+    const string & get_name() const override { return inner.get_name(); }
+    void add_card(const Card &c) override { inner.add_card(c); }
+    bool make_trump(const Card &upcard, bool is_dealer, int round,
+                    Suit &order_up_suit) const override {
+        return inner.make_trump(upcard, is_dealer, round, order_up_suit);
+    }
+    void add_and_discard(const Card &c) override { inner.add_and_discard(c); }
+    Card lead_card(Suit trump) override { return inner.lead_card(trump); }
+    Card play_card(const Card &led, Suit trump) override {
+        return inner.play_card(led, trump);
+    }
+
+private:
+    SimplePlayer inner;
+};
+
+// Returns the counts in after that are not in before
+static InstrumentSummary difference(const InstrumentSummary &before,
+                                    const InstrumentSummary &after) {
+    InstrumentSummary result = after;
+    for (int phase = 0; phase < NUM_PHASES; ++phase) {
+        result.phases[phase].calls -= before.phases[phase].calls;
+        result.phases[phase].ticks -= before.phases[phase].ticks;
+    }
+    for (auto &strategy : result.strategies) {
+        auto earlier = before.strategies.find(strategy.first);
+        for (int call = 0; call < NUM_CALLS && earlier != before.strategies.end();
+             ++call) {
+            strategy.second[call].calls -= earlier->second[call].calls;
+            strategy.second[call].ticks -= earlier->second[call].ticks;
+        }
+    }
+    return result;
+}
+
+// Plays a game between two SimplePlayers and two Wrapped ones, writing
+// the transcript to out if it is not null
+static GameResult play_game(ostream *out) {
+    SimplePlayer simple0("Simple0");
+    SimplePlayer simple2("Simple2");
+    Wrapped wrapped1;
+    Wrapped wrapped3;
+    vector<Player*> players = {&simple0, &wrapped1, &simple2, &wrapped3};
+    EuchreGame game(Pack(), false, 10, players, out);
+    game.use_random_shuffle(24);
+    return game.startGame();
+}
+
+static void assert_game_counts(const InstrumentSummary &counts, int hands) {
+    ASSERT_EQUAL(counts.phases[PHASE_SHUFFLE].calls, uint64_t(hands));
+    ASSERT_EQUAL(counts.phases[PHASE_DEAL].calls, uint64_t(hands));
+    ASSERT_EQUAL(counts.phases[PHASE_BID].calls, uint64_t(hands));
+    ASSERT_EQUAL(counts.phases[PHASE_TRICK].calls, uint64_t(5 * hands));
+    ASSERT_EQUAL(counts.phases[PHASE_SCORE].calls, uint64_t(hands));
+    ASSERT_TRUE(counts.phases[PHASE_TRICK].ticks > 0);
+    uint64_t make_trump = 0;
+    uint64_t discards = 0;
+    // each pair of seats plays ten cards a hand
+    for (const char *name : {"SimplePlayer", "Wrapped"}) {
+        auto strategy = counts.strategies.find(name);
+        ASSERT_TRUE(strategy != counts.strategies.end());
+        const auto &calls = strategy->second;
+        ASSERT_EQUAL(calls[CALL_LEAD_CARD].calls + calls[CALL_PLAY_CARD].calls,
+                     uint64_t(10 * hands));
+        make_trump += calls[CALL_MAKE_TRUMP].calls;
+        discards += calls[CALL_ADD_AND_DISCARD].calls;
+    }
+    ASSERT_EQUAL(counts.strategies.size(), size_t(2));
+    ASSERT_TRUE(make_trump >= uint64_t(hands));
+    ASSERT_TRUE(make_trump <= uint64_t(8 * hands));
+    ASSERT_TRUE(discards <= uint64_t(hands));
+}
+
+TEST(test_counts_one_game) {
+    const InstrumentSummary before = Instrument_summary();
+    const GameResult result = play_game(nullptr);
+    const InstrumentSummary counts = difference(before, Instrument_summary());
+    assert_game_counts(counts, result.hands_played);
+    // a headless game writes nothing
+    ASSERT_EQUAL(counts.phases[PHASE_OUTPUT].calls, uint64_t(0));
+}
+
+// Counts made on other threads are kept after the threads finish
+TEST(test_counts_other_threads) {
+    const InstrumentSummary before = Instrument_summary();
+    GameResult results[3];
+    vector<thread> threads;
+    for (GameResult &result : results) {
+        threads.emplace_back([&result] { result = play_game(nullptr); });
+    }
+    for (thread &t : threads) {
+        t.join();
+    }
+    const InstrumentSummary counts = difference(before, Instrument_summary());
+    assert_game_counts(counts, results[0].hands_played * 3);
+}
+
+TEST(test_counts_output) {
+    const InstrumentSummary before = Instrument_summary();
+    ostringstream transcript;
+    play_game(&transcript);
+    const InstrumentSummary counts = difference(before, Instrument_summary());
+    ASSERT_TRUE(counts.phases[PHASE_OUTPUT].calls >= 1);
+}
+
+TEST(test_print) {
+    ostringstream out;
+    play_game(nullptr);
+    Instrument_print(out, Instrument_summary());
+    const string text = out.str();
+    for (const char *name : {"shuffle", "deal", "bid", "trick", "score", "output",
+                             "SimplePlayer", "Wrapped", "make_trump", "play_card"}) {
+        ASSERT_TRUE(text.find(name) != string::npos);
+    }
+}
+
+// Printing leaves the stream formatted as the caller had it
+TEST(test_print_keeps_format) {
+    ostringstream out;
+    out << scientific << setprecision(3) << internal;
+    const ios::fmtflags flags = out.flags();
+    Instrument_print(out, Instrument_summary());
+    ASSERT_TRUE(out.flags() == flags);
+    ASSERT_EQUAL(out.precision(), 3);
+}
+
+TEST_MAIN()
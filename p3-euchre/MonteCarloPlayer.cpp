@@ -0,0 +1,79 @@
+#include "MonteCarloPlayer.hpp"
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+MonteCarloPlayer::MonteCarloPlayer(const string &name_in,
+                                   const MonteCarloConfig &config_in)
+  : SearchPlayer(name_in, config_in.threads), config(config_in),
+    workers(config_in.threads) {
+  assert(config.samples > 0 && config.threads > 0);
+}
+
+Card MonteCarloPlayer::choose(CardSet legal) {
+  ++decisions;
+  const uint64_t deadline = (config.time_limit_ms > 0)
+    ? now_ns() + static_cast<uint64_t>(config.time_limit_ms * 1e6) : 0;
+  const int threads = static_cast<int>(workers.size());
+  for (int t = 0; t < threads; ++t) {
+    Worker &worker = workers[t];
+    fill(worker.totals, worker.totals + NUM_CARDS, 0);
+    worker.samples = 0;
+    worker.rng.reseed(Rng::game_seed(Rng::game_seed(config.seed, get_seat()),
+                                     decisions * threads + t));
+  }
+  run_threads([this, deadline](int t) { sample(workers[t], t, deadline); });
+
+  // highest total wins; ties go to the lower card
+  long totals[NUM_CARDS] = {};
+  for (const Worker &worker : workers) {
+    sample_count += worker.samples;
+    for (int id = 0; id < NUM_CARDS; ++id) {
+      totals[id] += worker.totals[id];
+    }
+  }
+  Card best = legal.lowest(get_trump());
+  for (uint64_t m = legal.mask(); m != 0; m &= m - 1) {
+    Card c = CardSet::card_at(CardSet::count_trailing_zeros(m));
+    long diff = totals[Card_id(c)] - totals[Card_id(best)];
+    if (diff > 0 || (diff == 0 && Card_less(c, best, get_trump()))) {
+      best = c;
+    }
+  }
+  return best;
+}
+
+void MonteCarloPlayer::sample(Worker &worker, int first, uint64_t deadline_ns) {
+  const int threads = static_cast<int>(workers.size());
+  const int team = get_seat() % 2;
+  const bool makers = (get_maker() % 2 == team);
+  for (int i = first; i < config.samples; i += threads) {
+    // the first sample is always taken, so there is an answer
+    if (deadline_ns != 0 && i != 0 && now_ns() > deadline_ns) {
+      break;
+    }
+    DoubleDummyPosition position;
+    if (!deal_hidden(worker.rng, position)) {
+      continue;
+    }
+    Card moves[MAX_HAND_SIZE];
+    int tricks[MAX_HAND_SIZE];
+    int n = worker.solver.solve_moves(position, moves, tricks);
+    for (int k = 0; k < n; ++k) {
+      worker.totals[Card_id(moves[k])] +=
+        hand_score(get_tricks_won(team) + tricks[k], makers);
+    }
+    ++worker.samples;
+  }
+}
+
+bool MonteCarlo_parse_strategy(const string &strategy,
+                               MonteCarloConfig &config) {
+  const string prefix = "MonteCarlo";
+  if (strategy.compare(0, prefix.size(), prefix) != 0) {
+    return false;
+  }
+  return parse_search_budget(strategy.c_str() + prefix.size(), config.samples,
+                             config.time_limit_ms, config.threads);
+}
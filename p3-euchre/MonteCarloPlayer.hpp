@@ -0,0 +1,69 @@
+#ifndef MONTECARLOPLAYER_HPP
+#define MONTECARLOPLAYER_HPP
+/* MonteCarloPlayer.hpp
+ *
+ * The "MonteCarlo" computer strategy.  To choose a card it samples deals
+ * of the unseen cards that agree with everything seen so far (cards
+ * played, suits players have shown out of, the upcard), solves each deal
+ * double dummy for every card it may play, and plays the card with the
+ * best average score for the hand.  Bidding follows the Simple strategy.
+ *
+ * The player follows the play through the Player observation calls, so
+ * it needs a game that makes them; see SearchPlayer.
+ */
+
+
+#include "SearchPlayer.hpp"
+#include "CardSet.hpp"
+#include "DoubleDummy.hpp"
+#include "Random.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct MonteCarloConfig {
+  int samples = 16;           // deals sampled per decision
+  double time_limit_ms = 0;   // stop sampling after this long; 0 for none
+  int threads = 1;            // threads sampling in parallel
+  std::uint64_t seed = 0;     // sampling is reproducible for a given seed
+};
+
+class MonteCarloPlayer final : public SearchPlayer {
+public:
+  //REQUIRES config.samples > 0 and config.threads > 0
+  //EFFECTS Initializes a player with the given name and search budget
+  MonteCarloPlayer(const std::string &name_in,
+                   const MonteCarloConfig &config_in = MonteCarloConfig());
+
+  //EFFECTS Returns the number of deals sampled since construction
+  std::uint64_t samples_taken() const { return sample_count; }
+
+protected:
+  Card choose(CardSet legal) override;
+
+private:
+  // what one sampling thread needs of its own
+  struct Worker {
+    DoubleDummySolver solver;
+    Rng rng;
+    long totals[NUM_CARDS];  // summed scores, indexed by Card_id
+    int samples;
+    Worker() : solver(14) {}
+  };
+
+  MonteCarloConfig config;
+  std::uint64_t decisions = 0;
+  std::uint64_t sample_count = 0;
+  std::vector<Worker> workers;
+
+  // EFFECTS: Runs worker's share of the samples for the current decision
+  void sample(Worker &worker, int first, std::uint64_t deadline_ns);
+};
+
+//EFFECTS If strategy is "MonteCarlo", optionally followed by ":SAMPLES",
+//  ":SAMPLES:MILLISECONDS" or ":SAMPLES:MILLISECONDS:THREADS", sets the
+//  matching fields of config and returns true.  Otherwise returns false.
+bool MonteCarlo_parse_strategy(const std::string &strategy,
+                               MonteCarloConfig &config);
+
+#endif // MONTECARLOPLAYER_HPP
@@ -0,0 +1,194 @@
+#include "MonteCarloPlayer.hpp"
+#include "Game.hpp"
+#include "Pack.hpp"
+#include "Player.hpp"
+#include "Random.hpp"
+#include "SimplePlayer.hpp"
+#include "unit_test_framework.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Passes every call through to a MonteCarloPlayer and records whether it
+// ever revoked: played a suit after failing to follow it in the same hand
+class RevokeChecker : public Player {
+public:
+    RevokeChecker(const string &name, const MonteCarloConfig &config)
+        : inner(name, config) {}
+
+    const string & get_name() const override { return inner.get_name(); }
+    void add_card(const Card &c) override { inner.add_card(c); }
+    bool make_trump(const Card &upcard, bool is_dealer, int round,
+                    Suit &order_up_suit) const override {
+        return inner.make_trump(upcard, is_dealer, round, order_up_suit);
+    }
+    void add_and_discard(const Card &upcard) override {
+        inner.add_and_discard(upcard);
+    }
+    Card lead_card(Suit trump) override { return inner.lead_card(trump); }
+    Card play_card(const Card &led_card, Suit trump) override {
+        Card c = inner.play_card(led_card, trump);
+        Suit led = led_card.get_suit(trump);
+        if (c.get_suit(trump) != led) {
+            shown_out |= 1u << led;
+        }
+        return c;
+    }
+    void new_hand(int seat, int dealer) override {
+        me = seat;
+        shown_out = 0;
+        inner.new_hand(seat, dealer);
+    }
+    void trump_made(int maker, Suit trump_in, const Card &upcard,
+                    bool taken) override {
+        trump = trump_in;
+        inner.trump_made(maker, trump_in, upcard, taken);
+    }
+    void card_played(int seat, const Card &card) override {
+        if (seat == me && (shown_out & (1u << card.get_suit(trump)))) {
+            revoked = true;
+        }
+        inner.card_played(seat, card);
+    }
+
+    MonteCarloPlayer inner;
+    bool revoked = false;
+
+private:
+    int me = 0;
+    Suit trump = SPADES;
+    unsigned shown_out = 0;
+};
+
+// Plays one game of MonteCarlo players in seats 0 and 2 against Simple
+// players, with a random shuffle seeded by seed
+static GameResult play_against_simple(uint64_t seed, const MonteCarloConfig &config,
+                                      bool *revoked = nullptr) {
+    RevokeChecker north("North", config);
+    RevokeChecker south("South", config);
+    vector<Player*> players = {&north, Player_factory("East", "Simple"),
+                               &south, Player_factory("West", "Simple")};
+    EuchreGame game(Pack(), false, 10, players, nullptr);
+    game.use_random_shuffle(seed);
+    GameResult result = game.startGame();
+    delete players[1];
+    delete players[3];
+    if (revoked) {
+        *revoked = north.revoked || south.revoked;
+    }
+    ASSERT_TRUE(north.inner.samples_taken() > 0);
+    return result;
+}
+
+TEST(test_montecarlo_parse_strategy) {
+    MonteCarloConfig config;
+    ASSERT_TRUE(MonteCarlo_parse_strategy("MonteCarlo", config));
+    ASSERT_EQUAL(config.samples, MonteCarloConfig().samples);
+    ASSERT_TRUE(MonteCarlo_parse_strategy("MonteCarlo:40", config));
+    ASSERT_EQUAL(config.samples, 40);
+    ASSERT_TRUE(MonteCarlo_parse_strategy("MonteCarlo:8:0.5:2", config));
+    ASSERT_EQUAL(config.samples, 8);
+    ASSERT_ALMOST_EQUAL(config.time_limit_ms, 0.5, 1e-12);
+    ASSERT_EQUAL(config.threads, 2);
+
+    const char *bad[] = {"Simple", "MonteCarlos", "MonteCarlo:", "MonteCarlo:0",
+                         "MonteCarlo:x", "MonteCarlo:4:1:1:1", "MonteCarlo:4:-1"};
+    for (const char *strategy : bad) {
+        MonteCarloConfig unchanged;
+        ASSERT_FALSE(MonteCarlo_parse_strategy(strategy, unchanged));
+        ASSERT_EQUAL(unchanged.samples, MonteCarloConfig().samples);
+    }
+
+    Player *p = Player_factory("Ada", "MonteCarlo:4");
+    ASSERT_EQUAL(p->get_name(), "Ada");
+    delete p;
+}
+
+// Without the observation calls it still plays a legal card
+TEST(test_montecarlo_untracked_plays_legal) {
+    MonteCarloPlayer p("Ada");
+    p.add_card(Card(NINE, HEARTS));
+    p.add_card(Card(ACE, CLUBS));
+    p.add_card(Card(KING, HEARTS));
+    ASSERT_EQUAL(p.play_card(Card(TEN, HEARTS), SPADES), Card(KING, HEARTS));
+    ASSERT_EQUAL(p.lead_card(SPADES), Card(ACE, CLUBS));
+}
+
+// Without the observation calls it bids, discards and plays just as a
+// SimplePlayer holding the same cards
+TEST(test_montecarlo_untracked_plays_as_simple) {
+    Pack pack;
+    Rng rng(31);
+    for (int deal = 0; deal < 200; ++deal) {
+        pack.shuffle(rng);
+        MonteCarloPlayer searcher("Ada");
+        SimplePlayer simple("Bo");
+        for (int i = 0; i < 5; ++i) {
+            const Card c = pack.deal_one();
+            searcher.add_card(c);
+            simple.add_card(c);
+        }
+        const Card upcard = pack.deal_one();
+        for (int round = 1; round <= 2; ++round) {
+            for (bool dealer : {false, true}) {
+                Suit a = SPADES;
+                Suit b = SPADES;
+                ASSERT_EQUAL(searcher.make_trump(upcard, dealer, round, a),
+                             simple.make_trump(upcard, dealer, round, b));
+                ASSERT_EQUAL(a, b);
+            }
+        }
+        const Suit trump = upcard.get_suit();
+        searcher.add_and_discard(upcard);
+        simple.add_and_discard(upcard);
+        ASSERT_EQUAL(searcher.lead_card(trump), simple.lead_card(trump));
+        const Card led = pack.deal_one();
+        for (int trick = 1; trick < 5; ++trick) {
+            ASSERT_EQUAL(searcher.play_card(led, trump), simple.play_card(led, trump));
+        }
+    }
+}
+
+// Full games finish with legal play and are reproducible from the seeds
+TEST(test_montecarlo_games) {
+    MonteCarloConfig config;
+    config.samples = 8;
+    config.seed = 5;
+    for (uint64_t seed = 0; seed < 4; ++seed) {
+        bool revoked = true;
+        GameResult first = play_against_simple(seed, config, &revoked);
+        ASSERT_FALSE(revoked);
+        GameResult again = play_against_simple(seed, config);
+        ASSERT_EQUAL(first.points[0], again.points[0]);
+        ASSERT_EQUAL(first.hands_played, again.hands_played);
+    }
+}
+
+// Sampling on several threads is reproducible too
+TEST(test_montecarlo_threads) {
+    MonteCarloConfig config;
+    config.samples = 8;
+    config.threads = 3;
+    bool revoked = true;
+    GameResult first = play_against_simple(11, config, &revoked);
+    ASSERT_FALSE(revoked);
+    GameResult again = play_against_simple(11, config);
+    ASSERT_EQUAL(first.points[1], again.points[1]);
+    ASSERT_EQUAL(first.hands_played, again.hands_played);
+}
+
+// Looking ahead beats the Simple strategy over a run of games
+TEST(test_montecarlo_beats_simple) {
+    MonteCarloConfig config;
+    int points[2] = {0, 0};
+    for (uint64_t seed = 100; seed < 130; ++seed) {
+        GameResult result = play_against_simple(seed, config);
+        points[0] += result.points[0];
+        points[1] += result.points[1];
+    }
+    ASSERT_TRUE(points[0] > points[1]);
+}
+
+TEST_MAIN()
@@ -4,6 +4,7 @@
 #include <iostream>
 #include <sstream>
 #include <cassert>
+#include <utility>
 
 using namespace std;
 
@@ -32,6 +33,11 @@ Pack::Pack(std::istream& pack_input) {
   }
 }
 
+// 按给定顺序构造牌堆，order[0] 在最上面
+Pack::Pack(const std::array<Card, PackShuffle::SIZE> &order) : cards(order) {
+  reset();  // 重置牌堆的下一个索引
+}
+
 // 发一张牌
 Card Pack::deal_one() {
   assert(next < PACK_SIZE);  // 确保还有牌可以发
@@ -43,35 +49,34 @@ void Pack::reset() {
   next = 0;
 }
 
+// 七次 in shuffle 合成的置换，在编译期算好
+static constexpr PackShuffle SEVEN_IN_SHUFFLES =
+  PackShuffle::in_shuffle().repeat(7);
+
 // 洗牌函数，按照特定的算法洗牌，共洗 7 次
 void Pack::shuffle() {
+  shuffle(SEVEN_IN_SHUFFLES);
+}
+
+// 按给定的置换重排牌堆，一次拷贝完成
+void Pack::shuffle(const PackShuffle &order) {
+  static_assert(PackShuffle::SIZE == PACK_SIZE, "shuffle must cover the pack");
   next = 0;
-  std::array<Card, PACK_SIZE> temp;
-  const size_t half_size = PACK_SIZE / 2;
-  // 进行 7 次洗牌
-  for (size_t shuffle_count = 0; shuffle_count < 7; shuffle_count++) {
-    // 交替放置牌到临时数组
-    // i 从 0 到 half_size - 1（0 到 11）
-    for (size_t i = 0; i < half_size; i++) {
-      temp[2 * i] = cards[half_size + i]; 
-      temp[2 * i + 1] = cards[i];
-    }
-    // 将临时数组复制回原牌堆
-    for (size_t i = 0; i < PACK_SIZE; i++) {
-      cards[i] = temp[i];
-    }
+  const std::array<Card, PACK_SIZE> old = cards;
+  for (int i = 0; i < PACK_SIZE; i++) {
+    cards[i] = old[order[i]];
+  }
+}
+
+// 随机洗牌（Fisher-Yates），同一个种子总是得到同样的顺序
+void Pack::shuffle(Rng &rng) {
+  next = 0;
+  for (int i = PACK_SIZE - 1; i > 0; i--) {
+    int j = static_cast<int>(rng.below(i + 1));
+    std::swap(cards[i], cards[j]);
   }
 }
 
 bool Pack::empty() const {
   return (next == PACK_SIZE);
 }
-
-  // EFFECTS: returns true if there are no more cards left in the pack
-  bool Pack::empty() const{
-    if(next == PACK_SIZE){
-      return true;
-    }
-    return false;
-  }
-
@@ -10,9 +10,90 @@
 
 
 #include "Card.hpp"
+#include "Random.hpp"
 #include <array>
 #include <string>
 
+// A fixed rearrangement of the cards in a Pack.  After a PackShuffle p is
+// applied, position i holds the card that was at position p[i].  Shuffles
+// compose at compile time, so any sequence of in shuffles, out shuffles
+// and cuts costs a single pass over the pack.
+class PackShuffle {
+public:
+  static const int SIZE = 24;
+
+  // EFFECTS: Initializes the shuffle that leaves every card in place.
+  constexpr PackShuffle() : source() {
+    for (int i = 0; i < SIZE; ++i) {
+      source[i] = static_cast<unsigned char>(i);
+    }
+  }
+
+  // EFFECTS: Returns a perfect in shuffle: the bottom half and top half
+  //          are interleaved with the first card of the bottom half on
+  //          top.  See https://en.wikipedia.org/wiki/In_shuffle.
+  static constexpr PackShuffle in_shuffle() {
+    PackShuffle s;
+    for (int i = 0; i < SIZE / 2; ++i) {
+      s.source[2 * i] = static_cast<unsigned char>(SIZE / 2 + i);
+      s.source[2 * i + 1] = static_cast<unsigned char>(i);
+    }
+    return s;
+  }
+
+  // EFFECTS: Returns a perfect out shuffle, which keeps the top card on
+  //          top.
+  static constexpr PackShuffle out_shuffle() {
+    PackShuffle s;
+    for (int i = 0; i < SIZE / 2; ++i) {
+      s.source[2 * i] = static_cast<unsigned char>(i);
+      s.source[2 * i + 1] = static_cast<unsigned char>(SIZE / 2 + i);
+    }
+    return s;
+  }
+
+  // REQUIRES: 0 <= n < SIZE
+  // EFFECTS: Returns a cut that moves the top n cards to the bottom.
+  static constexpr PackShuffle cut(int n) {
+    PackShuffle s;
+    for (int i = 0; i < SIZE; ++i) {
+      s.source[i] = static_cast<unsigned char>((i + n) % SIZE);
+    }
+    return s;
+  }
+
+  // EFFECTS: Returns the shuffle that applies this one and then next.
+  constexpr PackShuffle then(const PackShuffle &next) const {
+    PackShuffle s;
+    for (int i = 0; i < SIZE; ++i) {
+      s.source[i] = source[next.source[i]];
+    }
+    return s;
+  }
+
+  // REQUIRES: k >= 0
+  // EFFECTS: Returns this shuffle applied k times.
+  constexpr PackShuffle repeat(int k) const {
+    PackShuffle result;
+    PackShuffle square = *this;
+    for (; k > 0; k /= 2) {
+      if (k % 2 == 1) {
+        result = result.then(square);
+      }
+      square = square.then(square);
+    }
+    return result;
+  }
+
+  // EFFECTS: Returns the position that position i takes its card from.
+  constexpr int operator[](int i) const {
+    return source[i];
+  }
+
+private:
+  std::array<unsigned char, SIZE> source;
+};
+
 class Pack {
 public:
   // EFFECTS: Initializes the Pack to be in the following standard order:
@@ -31,6 +112,10 @@ public:
   // NOTE: The pack is initially full, with no cards dealt.
   Pack(std::istream& pack_input);
 
+  // EFFECTS: Initializes Pack to hold order, with order[0] on top.
+  // NOTE: The pack is initially full, with no cards dealt.
+  explicit Pack(const std::array<Card, PackShuffle::SIZE> &order);
+
   // REQUIRES: cards remain in the Pack
   // EFFECTS: Returns the next card in the pack and increments the next index
   Card deal_one();
@@ -43,6 +128,14 @@ public:
   //          https://en.wikipedia.org/wiki/In_shuffle.
   void shuffle();
 
+  // EFFECTS: Rearranges the Pack by order and resets the next index.
+  void shuffle(const PackShuffle &order);
+
+  // MODIFIES: rng
+  // EFFECTS: Puts the Pack in a uniformly random order with a Fisher-Yates
+  //          shuffle driven by rng, and resets the next index.
+  void shuffle(Rng &rng);
+
   // EFFECTS: returns true if there are no more cards left in the pack
   bool empty() const;
 
@@ -2,6 +2,8 @@
 #include "unit_test_framework.hpp"
 
 #include <iostream>
+#include <vector>
+#include <algorithm>
 
 using namespace std;
 
@@ -12,6 +14,104 @@ TEST(test_pack_default_ctor) {
     ASSERT_EQUAL(SPADES, first.get_suit());
 }
 
-// Add more tests here
+// Deals the whole pack
+static vector<Card> deal_all(Pack &pack) {
+    vector<Card> cards;
+    while (!pack.empty()) {
+        cards.push_back(pack.deal_one());
+    }
+    return cards;
+}
+
+// The precomposed shuffle matches seven single in shuffles
+TEST(test_pack_shuffle_matches_in_shuffles) {
+    Pack composed;
+    composed.shuffle();
+    Pack stepwise;
+    for (int i = 0; i < 7; ++i) {
+        stepwise.shuffle(PackShuffle::in_shuffle());
+    }
+    ASSERT_SEQUENCE_EQUAL(deal_all(composed), deal_all(stepwise));
+}
+
+TEST(test_pack_in_shuffle_once) {
+    Pack pack;
+    pack.shuffle(PackShuffle::in_shuffle());
+    ASSERT_EQUAL(pack.deal_one(), Card(NINE, CLUBS));
+    ASSERT_EQUAL(pack.deal_one(), Card(NINE, SPADES));
+}
+
+TEST(test_pack_shuffle_resets_next) {
+    Pack pack;
+    pack.deal_one();
+    pack.shuffle(PackShuffle());
+    ASSERT_EQUAL(pack.deal_one(), Card(NINE, SPADES));
+}
+
+// A 24 card pack returns to order after 20 in shuffles, 11 out shuffles
+// or 24 single-card cuts
+TEST(test_pack_shuffle_orders) {
+    static_assert(PackShuffle::in_shuffle().repeat(20)[5] == 5,
+                  "composed at compile time");
+    Pack fresh;
+    vector<Card> start = deal_all(fresh);
+    PackShuffle shuffles[] = {PackShuffle::in_shuffle().repeat(20),
+                              PackShuffle::out_shuffle().repeat(11),
+                              PackShuffle::cut(1).repeat(24),
+                              PackShuffle::cut(5).then(PackShuffle::cut(19))};
+    for (const PackShuffle &s : shuffles) {
+        Pack pack;
+        pack.shuffle(s);
+        ASSERT_SEQUENCE_EQUAL(deal_all(pack), start);
+    }
+}
+
+// A random shuffle is a permutation and depends only on the seed
+TEST(test_pack_random_shuffle) {
+    Pack fresh;
+    vector<Card> start = deal_all(fresh);
+    Rng rng1(42);
+    Rng rng2(42);
+    Rng rng3(43);
+    Pack a, b, c;
+    a.shuffle(rng1);
+    b.shuffle(rng2);
+    c.shuffle(rng3);
+    vector<Card> dealt_a = deal_all(a);
+    vector<Card> dealt_c = deal_all(c);
+    ASSERT_SEQUENCE_EQUAL(dealt_a, deal_all(b));
+    ASSERT_FALSE(dealt_a == dealt_c);
+    sort(dealt_a.begin(), dealt_a.end());
+    sort(start.begin(), start.end());
+    ASSERT_SEQUENCE_EQUAL(dealt_a, start);
+}
+
+// Each position receives every card about equally often
+TEST(test_pack_random_shuffle_uniform) {
+    const int trials = 24000;
+    int top_count[24] = {};
+    Rng rng(7);
+    Pack fresh;
+    vector<Card> start = deal_all(fresh);
+    for (int t = 0; t < trials; ++t) {
+        Pack pack;
+        pack.shuffle(rng);
+        Card top = pack.deal_one();
+        for (int i = 0; i < 24; ++i) {
+            if (start[i] == top) {
+                ++top_count[i];
+            }
+        }
+    }
+    for (int i = 0; i < 24; ++i) {
+        ASSERT_TRUE(top_count[i] > 800 && top_count[i] < 1200);
+    }
+}
+
+TEST(test_pack_cut) {
+    Pack pack;
+    pack.shuffle(PackShuffle::cut(6));
+    ASSERT_EQUAL(pack.deal_one(), Card(NINE, HEARTS));
+}
 
 TEST_MAIN()
@@ -46,6 +46,25 @@ class Player {
   //  The card is removed from the player's hand.
   virtual Card play_card(const Card &led_card, Suit trump) = 0;
 
+  // The game reports what happens at the table through the calls below,
+  // so that strategies which track the play can follow along.  Each call
+  // goes to every player.  The default versions do nothing.
+
+  //EFFECTS  Called before the cards of each hand are dealt, with this
+  //  player's seat (0 to 3) and the dealer's seat.  Team 0 is seats 0
+  //  and 2.
+  virtual void new_hand(int seat, int dealer) {}
+
+  //EFFECTS  Called once trump is made.  maker is the seat that ordered up
+  //  trump, and upcard_taken is true if the dealer picked up the upcard
+  //  (trump was made in round 1).
+  virtual void trump_made(int maker, Suit trump, const Card &upcard,
+                          bool upcard_taken) {}
+
+  //EFFECTS  Called after each card is led or played, including this
+  //  player's own cards.
+  virtual void card_played(int seat, const Card &card) {}
+
   // Maximum number of cards in a player's hand
   static const int MAX_HAND_SIZE = 5;
 
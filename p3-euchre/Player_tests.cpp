@@ -1,5 +1,6 @@
 #include "Player.hpp"
 #include "Card.hpp"
+#include "SimplePlayer.hpp"
 #include "unit_test_framework.hpp"
 
 #include <iostream>
@@ -509,4 +510,32 @@ delete player3;
 
 
 
+// One player's hand dealt and played out, leading and following
+BENCHMARK(bench_simple_player_hand) {
+    SimplePlayer player("Bench");
+    const Card hand[] = {Card(JACK, CLUBS), Card(ACE, HEARTS), Card(NINE, SPADES),
+                         Card(KING, DIAMONDS), Card(TEN, CLUBS)};
+    for (const Card &card : hand) {
+        player.add_card(card);
+    }
+    player.lead_card(CLUBS);
+    for (int trick = 1; trick < 5; ++trick) {
+        player.play_card(Card(QUEEN, HEARTS), CLUBS);
+    }
+}
+
+// A hand dealt and bid on in both rounds
+BENCHMARK(bench_simple_player_make_trump) {
+    SimplePlayer bob("Bob");
+    bob.add_card(Card(JACK, HEARTS));
+    bob.add_card(Card(JACK, DIAMONDS));
+    bob.add_card(Card(ACE, HEARTS));
+    bob.add_card(Card(NINE, CLUBS));
+    bob.add_card(Card(TEN, SPADES));
+    const Card upcard(KING, HEARTS);
+    Suit trump = SPADES;
+    bob.make_trump(upcard, false, 1, trump);
+    bob.make_trump(upcard, true, 2, trump);
+}
+
 TEST_MAIN();
@@ -0,0 +1,82 @@
+#ifndef RANDOM_HPP
+#define RANDOM_HPP
+/* Random.hpp
+ *
+ * Small, fast, seedable random number generator (xoshiro256**, see
+ * https://prng.di.unimi.it/).  Every generator seeded with the same value
+ * produces the same sequence on every platform, so simulations that use
+ * one generator per game are reproducible and can run in parallel.
+ */
+
+
+#include <cstdint>
+
+class Rng {
+public:
+  //EFFECTS Initializes the generator from seed
+  explicit Rng(std::uint64_t seed = 0) {
+    reseed(seed);
+  }
+
+  //EFFECTS Restarts the generator from seed
+  void reseed(std::uint64_t seed) {
+    // expand the seed with splitmix64 so nearby seeds give unrelated
+    // streams and the state is never all zero
+    for (std::uint64_t &word : state) {
+      word = splitmix64(seed);
+    }
+  }
+
+  //EFFECTS Returns the next 64 random bits
+  std::uint64_t next() {
+    const std::uint64_t result = rotl(state[1] * 5, 7) * 9;
+    const std::uint64_t t = state[1] << 17;
+    state[2] ^= state[0];
+    state[3] ^= state[1];
+    state[1] ^= state[2];
+    state[0] ^= state[3];
+    state[2] ^= t;
+    state[3] = rotl(state[3], 45);
+    return result;
+  }
+
+  //REQUIRES 0 < bound <= 2^32
+  //EFFECTS Returns a uniformly distributed integer in [0, bound)
+  std::uint32_t below(std::uint64_t bound) {
+    // multiply-shift with rejection of the biased low products (Lemire)
+    std::uint64_t product = (next() >> 32) * bound;
+    std::uint32_t low = static_cast<std::uint32_t>(product);
+    if (low < bound) {
+      const std::uint32_t threshold =
+        static_cast<std::uint32_t>((std::uint64_t(1) << 32) % bound);
+      while (low < threshold) {
+        product = (next() >> 32) * bound;
+        low = static_cast<std::uint32_t>(product);
+      }
+    }
+    return static_cast<std::uint32_t>(product >> 32);
+  }
+
+  //EFFECTS Returns the seed for game number index of a run started from
+  //  base_seed.  Any single game can be replayed from this seed alone.
+  static std::uint64_t game_seed(std::uint64_t base_seed, std::uint64_t index) {
+    std::uint64_t x = base_seed ^ (index * 0xD1B54A32D192ED03ULL);
+    return splitmix64(x);
+  }
+
+private:
+  std::uint64_t state[4];
+
+  static std::uint64_t rotl(std::uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+  }
+
+  static std::uint64_t splitmix64(std::uint64_t &x) {
+    std::uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+  }
+};
+
+#endif // RANDOM_HPP
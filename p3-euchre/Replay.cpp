@@ -0,0 +1,71 @@
+#include "Replay.hpp"
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+// EFFECTS: Adds the march or euchre, if any, of the hand in record to result
+static void count_hand(const HandRecord &record, GameResult &result) {
+  int tricks[2] = {0, 0};
+  for (int trick = 0; trick < 5; ++trick) {
+    ++tricks[record.trick_winner(trick) % 2];
+  }
+  const int makers = record.maker() % 2;
+  const int winners = tricks[0] > tricks[1] ? 0 : 1;
+  if (winners != makers) {
+    ++result.euchres[winners];
+  } else if (tricks[winners] == 5) {
+    ++result.marches[winners];
+  }
+}
+
+GameCheckpoint Replay_checkpoint(const ReplaySetup &setup,
+                                 const HandRecord *records, int hand) {
+  assert(hand >= 0);
+  GameCheckpoint checkpoint;
+  checkpoint.pack = setup.pack;
+  checkpoint.hand = hand;
+  checkpoint.result.hands_played = hand;
+  if (setup.random_shuffle) {
+    // each shuffle draws a varying number of values, so they are rerun
+    checkpoint.rng.reseed(setup.seed);
+    for (int i = 0; i < hand; ++i) {
+      checkpoint.pack.shuffle(checkpoint.rng);
+    }
+  } else if (setup.shuffle) {
+    // seven in shuffles a hand, all at once
+    checkpoint.pack.shuffle(PackShuffle::in_shuffle().repeat(7 * hand));
+  }
+  for (int i = 0; i < hand; ++i) {
+    count_hand(records[i], checkpoint.result);
+  }
+  if (hand > 0) {
+    checkpoint.result.points[0] = records[hand - 1].points[0];
+    checkpoint.result.points[1] = records[hand - 1].points[1];
+  }
+  return checkpoint;
+}
+
+GameCheckpoint Replay_seek(EuchreGame &game,
+                           const vector<GameCheckpoint> &checkpoints, int hand) {
+  // the last checkpoint at or before hand
+  auto after = upper_bound(checkpoints.begin(), checkpoints.end(), hand,
+                           [](int h, const GameCheckpoint &c) { return h < c.hand; });
+  assert(after != checkpoints.begin());
+  game.restore(*(after - 1));
+  game.stop_before(hand);
+  game.startGame();
+  game.stop_before(-1);
+  return game.checkpoint();
+}
+
+DoubleDummyPosition Replay_position(const HandRecord &record, int trick) {
+  assert(0 <= trick && trick < 5);
+  DoubleDummyPosition position;
+  position.trump = record.trump();
+  position.leader = record.trick_leader(trick);
+  for (int i = 4 * trick; i < 20; ++i) {
+    position.hands[record.play_seat(i)].add(record.play(i));
+  }
+  return position;
+}
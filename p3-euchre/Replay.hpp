@@ -0,0 +1,58 @@
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+/* Replay.hpp
+ *
+ * Jumping into the middle of a saved game.  Between hands a game is only
+ * its pack, its shuffle generator and the score (GameCheckpoint), and the
+ * pack and generator do not depend on how the hands were played.  So the
+ * state before any hand can be rebuilt from the game's setup and its
+ * HandRecords without playing a card: the in shuffle is jumped forward
+ * in one step, the random shuffle is rerun without dealing, and the score
+ * is read off the records.  Without records, Replay_seek plays forward
+ * from the nearest checkpoint the game saved.
+ *
+ * Inside a hand, Replay_position gives the position at the start of any
+ * trick, ready for the double-dummy solver.
+ */
+
+
+#include "DoubleDummy.hpp"
+#include "Game.hpp"
+#include "GameRecord.hpp"
+#include "Pack.hpp"
+#include <cstdint>
+#include <vector>
+
+// How a game's pack is shuffled, as euchre.exe's options set it
+struct ReplaySetup {
+  Pack pack;                    // the pack the game started with
+  bool shuffle = false;
+  bool random_shuffle = false;  // overrides shuffle
+  std::uint64_t seed = 0;       // for the random shuffle
+};
+
+//REQUIRES hand >= 0, and records holds the game's hands 0 .. hand - 1
+//EFFECTS Returns the checkpoint the game had before hand number hand,
+//  with the pack and generator shuffled forward and the score taken from
+//  the records
+GameCheckpoint Replay_checkpoint(const ReplaySetup &setup,
+                                 const HandRecord *records, int hand);
+
+//REQUIRES game is set up as the game that saved checkpoints, which are in
+//  order of hand and start with hand 0
+//EFFECTS Restores game to the last of checkpoints that is not after hand
+//  number hand, plays it forward to that hand and returns the checkpoint
+//  there.  The game is left before that hand, ready to play on, or at its
+//  end if it ended sooner.  Hands played forward go to the game's
+//  transcript, so seek with a headless game and restore the checkpoint
+//  into one with a transcript to watch from there.
+GameCheckpoint Replay_seek(EuchreGame &game,
+                           const std::vector<GameCheckpoint> &checkpoints,
+                           int hand);
+
+//REQUIRES 0 <= trick < 5
+//EFFECTS Returns the position at the start of trick in the hand record
+//  holds: each player has the cards they play from then on
+DoubleDummyPosition Replay_position(const HandRecord &record, int trick);
+
+#endif // REPLAY_HPP
@@ -0,0 +1,215 @@
+#include "Replay.hpp"
+#include "Game.hpp"
+#include "GameRecord.hpp"
+#include "Pack.hpp"
+#include "Player.hpp"
+#include "unit_test_framework.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+using namespace std;
+
+// An all-Simple game with its players, set up as setup says
+class SimpleTable {
+public:
+    SimpleTable(const ReplaySetup &setup, int points) {
+        for (int seat = 0; seat < 4; ++seat) {
+            players.push_back(Player_factory("Player", "Simple"));
+        }
+        game = new EuchreGame(setup.pack, setup.shuffle, points, players, nullptr);
+        if (setup.random_shuffle) {
+            game->use_random_shuffle(setup.seed);
+        }
+    }
+    ~SimpleTable() {
+        delete game;
+        for (Player *p : players) {
+            delete p;
+        }
+    }
+
+    vector<Player*> players;
+    EuchreGame *game;
+};
+
+static void assert_same_pack(Pack a, Pack b) {
+    a.reset();
+    b.reset();
+    while (!a.empty()) {
+        ASSERT_EQUAL(a.deal_one(), b.deal_one());
+    }
+}
+
+static void assert_same(const GameCheckpoint &a, const GameCheckpoint &b) {
+    assert_same_pack(a.pack, b.pack);
+    Rng rng_a = a.rng;
+    Rng rng_b = b.rng;
+    ASSERT_EQUAL(rng_a.next(), rng_b.next());
+    ASSERT_EQUAL(a.hand, b.hand);
+    ASSERT_EQUAL(a.result.hands_played, b.result.hands_played);
+    for (int team = 0; team < 2; ++team) {
+        ASSERT_EQUAL(a.result.points[team], b.result.points[team]);
+        ASSERT_EQUAL(a.result.marches[team], b.result.marches[team]);
+        ASSERT_EQUAL(a.result.euchres[team], b.result.euchres[team]);
+    }
+}
+
+static ReplaySetup make_setup(int mode) {
+    ReplaySetup setup;
+    ifstream pack_in("pack.in");
+    setup.pack = Pack(pack_in);
+    setup.shuffle = mode == 1;
+    setup.random_shuffle = mode == 2;
+    setup.seed = 280;
+    return setup;
+}
+
+// A game restored to any checkpoint plays the rest exactly as it went
+TEST(test_restore_plays_on_alike) {
+    const ReplaySetup setup = make_setup(2);
+    SimpleTable original(setup, 30);
+    vector<GameCheckpoint> checkpoints;
+    vector<HandRecord> records;
+    original.game->set_checkpoints(&checkpoints, 1);
+    original.game->set_record(&records, 0);
+    GameResult expected = original.game->startGame();
+    ASSERT_EQUAL(checkpoints.size(), size_t(expected.hands_played));
+
+    for (int hand = 0; hand < expected.hands_played; hand += 5) {
+        SimpleTable table(setup, 30);
+        vector<HandRecord> replayed;
+        table.game->set_record(&replayed, 0);
+        table.game->restore(checkpoints[hand]);
+        GameResult result = table.game->startGame();
+        ASSERT_EQUAL(result.winner, expected.winner);
+        ASSERT_EQUAL(result.points[1], expected.points[1]);
+        ASSERT_EQUAL(result.euchres[0], expected.euchres[0]);
+        ASSERT_EQUAL(result.hands_played, expected.hands_played);
+        ASSERT_EQUAL(replayed.size(), records.size() - hand);
+        ASSERT_EQUAL(memcmp(replayed.data(), records.data() + hand,
+                            replayed.size() * sizeof(HandRecord)), 0);
+    }
+}
+
+// The checkpoint rebuilt from the records is the one the game saved, for
+// every way of shuffling
+TEST(test_checkpoint_from_records) {
+    for (int mode = 0; mode < 3; ++mode) {
+        const ReplaySetup setup = make_setup(mode);
+        SimpleTable original(setup, 40);
+        vector<GameCheckpoint> checkpoints;
+        vector<HandRecord> records;
+        original.game->set_checkpoints(&checkpoints, 1);
+        original.game->set_record(&records, 0);
+        original.game->startGame();
+        for (size_t hand = 0; hand < checkpoints.size(); ++hand) {
+            assert_same(Replay_checkpoint(setup, records.data(), hand),
+                        checkpoints[hand]);
+        }
+    }
+}
+
+// A long game resumed from its record file, with scores past what a byte
+// holds, plays on as it went
+TEST(test_resume_long_game) {
+    const ReplaySetup setup = make_setup(2);
+    SimpleTable original(setup, 1000);
+    vector<GameCheckpoint> checkpoints;
+    vector<HandRecord> played;
+    original.game->set_checkpoints(&checkpoints, 100);
+    original.game->set_record(&played, 0);
+    GameResult expected = original.game->startGame();
+    ASSERT_TRUE(expected.hands_played > 400);
+    {
+        ofstream out("Replay_test.bin", ios::binary);
+        GameRecordWriter writer(out);
+        writer.write(played);
+    }
+    GameRecordReader reader("Replay_test.bin");
+    ASSERT_EQUAL(reader.size(), played.size());
+
+    const GameCheckpoint resumed = Replay_checkpoint(setup, reader.begin(), 400);
+    assert_same(resumed, checkpoints[4]);
+    ASSERT_TRUE(resumed.result.points[0] > 255 && resumed.result.points[1] > 255);
+    SimpleTable table(setup, 1000);
+    table.game->restore(resumed);
+    GameResult result = table.game->startGame();
+    ASSERT_EQUAL(result.winner, expected.winner);
+    ASSERT_EQUAL(result.points[0], expected.points[0]);
+    ASSERT_EQUAL(result.points[1], expected.points[1]);
+    ASSERT_EQUAL(result.hands_played, expected.hands_played);
+    remove("Replay_test.bin");
+}
+
+// Seeking from sparse checkpoints reaches the same state as playing through
+TEST(test_seek_from_checkpoints) {
+    const ReplaySetup setup = make_setup(2);
+    SimpleTable original(setup, 30);
+    vector<GameCheckpoint> every_hand;
+    original.game->set_checkpoints(&every_hand, 1);
+    original.game->startGame();
+
+    SimpleTable sparse(setup, 30);
+    vector<GameCheckpoint> every_eighth;
+    sparse.game->set_checkpoints(&every_eighth, 8);
+    sparse.game->startGame();
+    ASSERT_EQUAL(every_eighth.size(), (every_hand.size() + 7) / 8);
+
+    const int hands[] = {0, 7, 8, 13, int(every_hand.size()) - 1};
+    for (int hand : hands) {
+        SimpleTable table(setup, 30);
+        assert_same(Replay_seek(*table.game, every_eighth, hand), every_hand[hand]);
+        // and play goes on from there
+        GameCheckpoint next = table.game->checkpoint();
+        ASSERT_EQUAL(next.hand, hand);
+    }
+}
+
+// A game stopped before a hand plays on to the same end
+TEST(test_stop_before) {
+    const ReplaySetup setup = make_setup(1);
+    SimpleTable whole(setup, 10);
+    GameResult expected = whole.game->startGame();
+
+    SimpleTable halves(setup, 10);
+    halves.game->stop_before(3);
+    GameResult first = halves.game->startGame();
+    ASSERT_EQUAL(first.hands_played, 3);
+    halves.game->stop_before(-1);
+    GameResult rest = halves.game->startGame();
+    ASSERT_EQUAL(rest.hands_played, expected.hands_played);
+    ASSERT_EQUAL(rest.points[0], expected.points[0]);
+    ASSERT_EQUAL(rest.winner, expected.winner);
+}
+
+// Each trick's position holds the cards still to be played
+TEST(test_position_at_trick) {
+    const ReplaySetup setup = make_setup(2);
+    SimpleTable table(setup, 10);
+    vector<HandRecord> records;
+    table.game->set_record(&records, 0);
+    table.game->startGame();
+    DoubleDummySolver solver;
+    for (const HandRecord &record : records) {
+        for (int trick = 0; trick < 5; ++trick) {
+            DoubleDummyPosition position = Replay_position(record, trick);
+            ASSERT_EQUAL(position.trump, record.trump());
+            ASSERT_EQUAL(position.leader, record.trick_leader(trick));
+            for (int seat = 0; seat < 4; ++seat) {
+                ASSERT_EQUAL(position.hands[seat].size(), 5 - trick);
+            }
+            // the players who were not the dealer hold what they were dealt
+            const int seat = (record.dealer() + 1) % 4;
+            if (trick == 0) {
+                ASSERT_EQUAL(position.hands[seat].mask(), record.dealt(seat).mask());
+            }
+            const int tricks = solver.solve(position, 0);
+            ASSERT_TRUE(0 <= tricks && tricks <= 5 - trick);
+        }
+    }
+}
+
+TEST_MAIN()
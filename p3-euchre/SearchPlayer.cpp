@@ -0,0 +1,219 @@
+#include "SearchPlayer.hpp"
+#include "SimplePlayer.hpp"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+
+namespace {
+
+// every card from Nine to Ace
+const uint64_t EUCHRE_CARDS = 0xFFFFFFULL << (NINE * 4);
+
+// tries at a deal that respects every known void before giving up on them
+const int DEAL_ATTEMPTS = 8;
+
+} // namespace
+
+void SearchPlayer::add_card(const Card &c) {
+  assert(hand.size() < MAX_HAND_SIZE);
+  hand.add(c);
+}
+
+bool SearchPlayer::make_trump(const Card &upcard_in, bool is_dealer,
+                              int round, Suit &order_up_suit) const {
+  // bids as the Simple strategy does
+  if (!Simple_orders_up(hand, upcard_in, is_dealer, round)) {
+    return false;
+  }
+  order_up_suit = Simple_bid_suit(upcard_in, round);
+  return true;
+}
+
+void SearchPlayer::add_and_discard(const Card &upcard_in) {
+  assert(hand.size() >= 1);
+  const Card discard = Simple_discard(hand, upcard_in);
+  hand.add(upcard_in);
+  hand.remove(discard);
+  seen.add(discard);
+}
+
+Card SearchPlayer::lead_card(Suit trump_in) {
+  assert(hand.size() >= 1);
+  if (!tracking || trick_size != 0) {
+    // not told about the hand; lead as the Simple strategy does
+    return play(Simple_lead(hand, trump_in));
+  }
+  return play(hand.size() == 1 ? hand.lowest() : choose(hand));
+}
+
+Card SearchPlayer::play_card(const Card &led_card, Suit trump_in) {
+  assert(hand.size() >= 1);
+  if (!tracking || trick_size == 0 || !(trick[0] == led_card)) {
+    // not told about the trick; play as the Simple strategy does
+    return play(Simple_follow(hand, led_card, trump_in));
+  }
+  const Suit led_suit = led_card.get_suit(trump_in);
+  CardSet follow = hand & CardSet::suit_cards(led_suit, trump_in);
+  CardSet legal = follow.empty() ? hand : follow;
+  return play(legal.size() == 1 ? legal.lowest() : choose(legal));
+}
+
+void SearchPlayer::new_hand(int seat_in, int dealer_in) {
+  tracking = true;
+  seat = seat_in;
+  dealer = dealer_in;
+  upcard_taken = false;
+  hand = CardSet();
+  seen = CardSet();
+  for (int s = 0; s < 4; ++s) {
+    cards_left[s] = MAX_HAND_SIZE;
+    voids[s] = 0;
+  }
+  trick_size = 0;
+  tricks_won[0] = tricks_won[1] = 0;
+}
+
+void SearchPlayer::trump_made(int maker_in, Suit trump_in,
+                              const Card &upcard_in, bool upcard_taken_in) {
+  maker = maker_in;
+  trump = trump_in;
+  upcard = upcard_in;
+  upcard_taken = upcard_taken_in;
+}
+
+void SearchPlayer::card_played(int seat_in, const Card &card) {
+  seen.add(card);
+  --cards_left[seat_in];
+  if (trick_size == 0) {
+    trick_leader = seat_in;
+  } else if (card.get_suit(trump) != trick[0].get_suit(trump)) {
+    voids[seat_in] |= 1u << trick[0].get_suit(trump);
+  }
+  trick[trick_size++] = card;
+  if (trick_size == 4) {
+    int winner = 0;
+    for (int i = 1; i < 4; ++i) {
+      if (Card_less(trick[winner], trick[i], trick[0], trump)) {
+        winner = i;
+      }
+    }
+    ++tricks_won[(trick_leader + winner) % 2];
+    trick_size = 0;
+  }
+}
+
+Card SearchPlayer::play(const Card &card) {
+  hand.remove(card);
+  return card;
+}
+
+bool SearchPlayer::deal_hidden(Rng &rng, DoubleDummyPosition &position) const {
+  position.trump = trump;
+  position.leader = (trick_size == 0) ? seat : trick_leader;
+  position.played = trick_size;
+  copy(trick, trick + trick_size, position.trick);
+  int need[4];
+  for (int s = 0; s < 4; ++s) {
+    position.hands[s] = CardSet();
+    need[s] = (s == seat) ? 0 : cards_left[s];
+  }
+  position.hands[seat] = hand;
+
+  // the dealer holds the upcard until they play it, unless they threw it
+  // away, which shows once they fail to follow its suit
+  const CardSet upcard_set(CardSet::bit(upcard));
+  CardSet pool = CardSet(EUCHRE_CARDS).without(hand | seen | upcard_set);
+  if (upcard_taken && dealer != seat && !seen.contains(upcard) &&
+      (voids[dealer] & (1u << upcard.get_suit(trump))) == 0) {
+    position.hands[dealer].add(upcard);
+    --need[dealer];
+  }
+
+  Card cards[NUM_EUCHRE_CARDS];
+  int count = 0;
+  for (uint64_t m = pool.mask(); m != 0; m &= m - 1) {
+    cards[count++] = CardSet::card_at(CardSet::count_trailing_zeros(m));
+  }
+  int order[3];
+  deal_order(order);
+
+  for (int attempt = 0; attempt < DEAL_ATTEMPTS; ++attempt) {
+    const bool respect_voids = (attempt + 1 < DEAL_ATTEMPTS);
+    for (int i = count - 1; i > 0; --i) {
+      swap(cards[i], cards[rng.below(i + 1)]);
+    }
+    CardSet hidden[4];
+    CardSet dealt;
+    bool ok = true;
+    for (int s : order) {
+      for (int k = 0; k < count && hidden[s].size() < need[s]; ++k) {
+        bool allowed = !respect_voids ||
+          (voids[s] & (1u << cards[k].get_suit(trump))) == 0;
+        if (allowed && !dealt.contains(cards[k])) {
+          hidden[s].add(cards[k]);
+          dealt.add(cards[k]);
+        }
+      }
+      ok = ok && hidden[s].size() == need[s];
+    }
+    if (ok) {
+      for (int s : order) {
+        position.hands[s] = position.hands[s] | hidden[s];
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+void SearchPlayer::deal_order(int order[3]) const {
+  // deal first to the players with the most known voids
+  for (int i = 0, s = 0; s < 4; ++s) {
+    if (s != seat) {
+      order[i++] = s;
+    }
+  }
+  sort(order, order + 3, [this](int a, int b) {
+    return CardSet::popcount(voids[a]) > CardSet::popcount(voids[b]);
+  });
+}
+
+int SearchPlayer::hand_score(int tricks, bool makers) {
+  if (makers) {
+    return (tricks == 5) ? 2 : (tricks >= 3) ? 1 : -2;
+  }
+  return (tricks >= 3) ? 2 : (tricks == 0) ? -2 : -1;
+}
+
+uint64_t SearchPlayer::now_ns() {
+  return chrono::duration_cast<chrono::nanoseconds>(
+    chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool parse_search_budget(const char *text, int &count, double &time_limit_ms,
+                         int &threads) {
+  double fields[3] = {static_cast<double>(count), time_limit_ms,
+                      static_cast<double>(threads)};
+  const char *p = text;
+  for (int field = 0; *p != '\0'; ++field) {
+    char *end = nullptr;
+    if (*p != ':' || field > 2) {
+      return false;
+    }
+    fields[field] = strtod(p + 1, &end);
+    if (end == p + 1 || (*end != ':' && *end != '\0')) {
+      return false;
+    }
+    p = end;
+  }
+  if (fields[0] < 1 || fields[1] < 0 || fields[2] < 1) {
+    return false;
+  }
+  count = static_cast<int>(fields[0]);
+  time_limit_ms = fields[1];
+  threads = static_cast<int>(fields[2]);
+  return true;
+}
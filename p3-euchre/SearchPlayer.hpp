@@ -0,0 +1,119 @@
+#ifndef SEARCHPLAYER_HPP
+#define SEARCHPLAYER_HPP
+/* SearchPlayer.hpp
+ *
+ * Base class for the computer strategies that choose cards by searching
+ * sampled deals.  It bids and discards as the Simple strategy does,
+ * follows the play through the Player observation calls, and deals the
+ * unseen cards at random in a way that agrees with everything seen so
+ * far (cards played, suits players have shown out of, the upcard).
+ *
+ * A derived class supplies choose, which is only called once the player
+ * has been told about the hand and has more than one legal card.
+ * Without the observation calls it plays as the Simple strategy does.
+ * It assumes a 24-card euchre pack.
+ *
+ * A search on several threads runs on the player's WorkerPool, whose
+ * threads live as long as the player, so a decision does not pay for
+ * starting threads.
+ */
+
+
+#include "Player.hpp"
+#include "CardSet.hpp"
+#include "DoubleDummy.hpp"
+#include "Random.hpp"
+#include "WorkerPool.hpp"
+#include <cstdint>
+#include <functional>
+#include <string>
+
+class SearchPlayer : public Player {
+public:
+  const std::string & get_name() const override { return name; }
+  void add_card(const Card &c) override;
+  bool make_trump(const Card &upcard, bool is_dealer,
+                  int round, Suit &order_up_suit) const override;
+  void add_and_discard(const Card &upcard) override;
+  Card lead_card(Suit trump) override;
+  Card play_card(const Card &led_card, Suit trump) override;
+
+  void new_hand(int seat, int dealer) override;
+  void trump_made(int maker, Suit trump, const Card &upcard,
+                  bool upcard_taken) override;
+  void card_played(int seat, const Card &card) override;
+
+protected:
+  //REQUIRES threads > 0
+  //EFFECTS Initializes a player with the given name that searches on
+  //  threads threads
+  SearchPlayer(const std::string &name_in, int threads)
+    : name(name_in), pool(threads) {}
+
+  //REQUIRES legal holds at least two cards of the player's hand
+  //EFFECTS Returns the card to play from legal
+  virtual Card choose(CardSet legal) = 0;
+
+  //EFFECTS Fills in position with the current trick and a random deal
+  //  of the unseen cards that agrees with what has been seen.  Returns
+  //  false if none was found.
+  bool deal_hidden(Rng &rng, DoubleDummyPosition &position) const;
+
+  int get_seat() const { return seat; }
+  int get_maker() const { return maker; }
+  Suit get_trump() const { return trump; }
+
+  //EFFECTS Returns the tricks team has taken so far this hand
+  int get_tricks_won(int team) const { return tricks_won[team]; }
+
+  //EFFECTS Returns the points a hand is worth to a team that takes tricks
+  //  of the five, less the points it gives the other team
+  static int hand_score(int tricks, bool makers);
+
+  //EFFECTS Returns a steady clock reading in nanoseconds
+  static std::uint64_t now_ns();
+
+  //EFFECTS Returns the number of threads a search runs on
+  int get_threads() const { return pool.size(); }
+
+  //EFFECTS Calls job(t) for every thread t of the search at once, and
+  //  returns when all have returned
+  void run_threads(const std::function<void(int)> &job) { pool.run(job); }
+
+private:
+  std::string name;
+  CardSet hand;
+  WorkerPool pool;
+
+  // the hand so far, as reported by the game
+  bool tracking = false;      // false until new_hand is called
+  int seat = 0;
+  int dealer = 0;
+  int maker = 0;
+  Suit trump = SPADES;
+  Card upcard;
+  bool upcard_taken = false;
+  CardSet seen;               // cards played, plus ones known to be out
+  int cards_left[4] = {0, 0, 0, 0};
+  unsigned voids[4] = {0, 0, 0, 0};  // bit s set if the player has no suit s
+  Card trick[4];
+  int trick_leader = 0;
+  int trick_size = 0;
+  int tricks_won[2] = {0, 0};
+
+  // EFFECTS: Stores the other players in order, the ones with the most
+  //          known voids first
+  void deal_order(int order[3]) const;
+
+  // EFFECTS: Removes card from hand and returns it
+  Card play(const Card &card);
+};
+
+//EFFECTS If text is empty, or ":COUNT", ":COUNT:MILLISECONDS" or
+//  ":COUNT:MILLISECONDS:THREADS" with COUNT and THREADS above zero and
+//  MILLISECONDS not negative, sets the given fields and returns true.
+//  Otherwise returns false and leaves them alone.
+bool parse_search_budget(const char *text, int &count, double &time_limit_ms,
+                         int &threads);
+
+#endif // SEARCHPLAYER_HPP
@@ -0,0 +1,608 @@
+#include "SimpleBatch.hpp"
+#include "CardSet.hpp"
+#include <cassert>
+#if defined(__AVX2__) || defined(__AVX512F__)
+// GCC 12 warns, wrongly, that the AVX-512 intrinsics use the undefined
+// vectors they start from once they are inlined at -O2
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#endif
+
+using namespace std;
+
+namespace {
+
+// one bit for each rank of suit 0
+const uint64_t SUIT0 = 0x1111111111111ULL;
+
+// every card of rank JACK or higher
+const uint64_t FACES = 0xFFFFULL << (JACK * 4);
+
+inline uint64_t bit(int id) {
+  return uint64_t(1) << id;
+}
+
+inline int right_bower(int trump) {
+  return JACK * 4 + trump;
+}
+
+inline int left_bower(int trump) {
+  return JACK * 4 + (trump ^ 2);
+}
+
+// every trump card, including the left bower
+inline uint64_t trump_mask(int trump) {
+  return (SUIT0 << trump) | bit(left_bower(trump));
+}
+
+// every card of suit, treating the left bower as trump
+inline uint64_t suit_mask(int suit, int trump) {
+  const uint64_t plain = (SUIT0 << suit) & ~bit(left_bower(trump));
+  return (suit == trump) ? trump_mask(trump) : plain;
+}
+
+// effective suit of card id
+inline int suit_of(int id, int trump) {
+  return (id == left_bower(trump)) ? trump : (id & 3);
+}
+
+// Both sides of every choice below are worked out and one is selected,
+// which compiles to conditional moves instead of hard-to-predict branches.
+// The guard bits keep the bit scans defined for an empty set; the result
+// is then unused.
+
+inline int highest(uint64_t cards) {
+  return 63 - CardSet::count_leading_zeros(cards | 1);
+}
+
+inline int lowest(uint64_t cards) {
+  return CardSet::count_trailing_zeros(cards | (uint64_t(1) << 63));
+}
+
+// REQUIRES: cards holds only trumps
+inline int highest_trump(uint64_t cards, int trump) {
+  const int right = right_bower(trump);
+  const int left = left_bower(trump);
+  const int top = highest(cards);
+  return (cards & bit(right)) ? right : (cards & bit(left)) ? left : top;
+}
+
+inline int lowest_trump(uint64_t cards, int trump) {
+  const int right = right_bower(trump);
+  const int left = left_bower(trump);
+  const uint64_t plain = cards & ~(bit(right) | bit(left));
+  const int bottom = lowest(plain);
+  return plain ? bottom : (cards & bit(left)) ? left : right;
+}
+
+// The Simple strategy's choices, as in SimplePlayer
+
+// EFFECTS: Returns the card the dealer throws away from hand
+inline int discard_card(uint64_t hand, int trump) {
+  const uint64_t plain = hand & ~trump_mask(trump);
+  const int bottom = lowest(plain);
+  const int bottom_trump = lowest_trump(hand, trump);
+  return plain ? bottom : bottom_trump;
+}
+
+// EFFECTS: Returns the card led from hand
+inline int lead_card(uint64_t hand, int trump) {
+  const uint64_t plain = hand & ~trump_mask(trump);
+  const int top = highest(plain);
+  const int top_trump = highest_trump(hand, trump);
+  return plain ? top : top_trump;
+}
+
+// EFFECTS: Returns the card played from hand when led is led
+inline int follow_card(uint64_t hand, int led, int trump) {
+  const uint64_t follow = hand & suit_mask(led, trump);
+  const int top = (led == trump) ? highest_trump(follow, trump) : highest(follow);
+  const int throw_away = discard_card(hand, trump);
+  return follow ? top : throw_away;
+}
+
+// EFFECTS: Returns true if a player holding hand makes trump in round,
+//          with is_dealer set if they deal
+inline bool orders_up(uint64_t hand, int trump, int round, bool is_dealer) {
+  const int faces = CardSet::popcount(hand & trump_mask(trump) & FACES);
+  return (round == 1) ? faces >= 2 : (faces >= 1 || is_dealer);
+}
+
+} // namespace
+
+#if defined(__AVX512F__) && defined(__AVX512CD__)
+#define BATCH_SIMD 1
+
+// Eight lanes at a time, with one mask bit per lane for conditions
+namespace simd {
+
+const int WIDTH = 8;
+using V = __m512i;
+using M = __mmask8;
+
+inline V load(const void *p) { return _mm512_loadu_si512(p); }
+inline void store(void *p, V a) { _mm512_storeu_si512(p, a); }
+inline V set(int64_t x) { return _mm512_set1_epi64(x); }
+inline V add(V a, V b) { return _mm512_add_epi64(a, b); }
+inline V sub(V a, V b) { return _mm512_sub_epi64(a, b); }
+inline V bit_and(V a, V b) { return _mm512_and_si512(a, b); }
+inline V bit_or(V a, V b) { return _mm512_or_si512(a, b); }
+inline V bit_xor(V a, V b) { return _mm512_xor_si512(a, b); }
+inline V and_not(V a, V b) { return _mm512_andnot_si512(b, a); }   // a & ~b
+inline V shl(V a, V n) { return _mm512_sllv_epi64(a, n); }
+inline V shr(V a, V n) { return _mm512_srlv_epi64(a, n); }
+inline M eq(V a, V b) { return _mm512_cmpeq_epi64_mask(a, b); }
+inline M gt(V a, V b) { return _mm512_cmpgt_epi64_mask(a, b); }
+inline M nonzero(V a) { return _mm512_test_epi64_mask(a, a); }
+inline M both(M a, M b) { return a & b; }
+inline M either(M a, M b) { return a | b; }
+
+// lanes in m take a, the others b
+inline V select(M m, V a, V b) { return _mm512_mask_blend_epi64(m, b, a); }
+
+// the index of the highest bit of each nonzero lane
+inline V highest(V a) { return sub(set(63), _mm512_lzcnt_epi64(a)); }
+
+} // namespace simd
+
+#elif defined(__AVX2__)
+#define BATCH_SIMD 1
+
+// Four lanes at a time; a condition is all ones or all zeros in a lane
+namespace simd {
+
+const int WIDTH = 4;
+using V = __m256i;
+using M = __m256i;
+
+inline V load(const void *p) {
+  return _mm256_loadu_si256(static_cast<const __m256i *>(p));
+}
+inline void store(void *p, V a) { _mm256_storeu_si256(static_cast<__m256i *>(p), a); }
+inline V set(int64_t x) { return _mm256_set1_epi64x(x); }
+inline V add(V a, V b) { return _mm256_add_epi64(a, b); }
+inline V sub(V a, V b) { return _mm256_sub_epi64(a, b); }
+inline V bit_and(V a, V b) { return _mm256_and_si256(a, b); }
+inline V bit_or(V a, V b) { return _mm256_or_si256(a, b); }
+inline V bit_xor(V a, V b) { return _mm256_xor_si256(a, b); }
+inline V and_not(V a, V b) { return _mm256_andnot_si256(b, a); }   // a & ~b
+inline V shl(V a, V n) { return _mm256_sllv_epi64(a, n); }
+inline V shr(V a, V n) { return _mm256_srlv_epi64(a, n); }
+inline M eq(V a, V b) { return _mm256_cmpeq_epi64(a, b); }
+inline M gt(V a, V b) { return _mm256_cmpgt_epi64(a, b); }
+inline M nonzero(V a) { return bit_xor(eq(a, set(0)), set(-1)); }
+inline M both(M a, M b) { return bit_and(a, b); }
+inline M either(M a, M b) { return bit_or(a, b); }
+
+// lanes in m take a, the others b
+inline V select(M m, V a, V b) { return _mm256_blendv_epi8(b, a, m); }
+
+// The index of the highest bit of each nonzero lane.  AVX2 has no bit
+// scan, but every card lies below bit 52, so a lane converts exactly to
+// a double by way of the bits of 2^52, and the double's exponent is the
+// index.
+inline V highest(V a) {
+  const V two52 = set(0x4330000000000000LL);
+  const __m256d exact = _mm256_sub_pd(_mm256_castsi256_pd(bit_or(a, two52)),
+                                      _mm256_castsi256_pd(two52));
+  return sub(shr(_mm256_castpd_si256(exact), set(52)), set(1023));
+}
+
+} // namespace simd
+
+#endif
+
+#ifdef BATCH_SIMD
+
+// The Simple strategy on a register of lanes, as above.  Both sides of
+// every choice are worked out and selected per lane; the bit scans of an
+// empty set give junk that is never selected.
+namespace simd {
+
+inline V bit(V id) {
+  return shl(set(1), id);
+}
+
+inline V right_bower(V trump) {
+  return add(set(JACK * 4), trump);
+}
+
+inline V left_bower(V trump) {
+  return add(set(JACK * 4), bit_xor(trump, set(2)));
+}
+
+inline M has(V cards, V id) {
+  return nonzero(bit_and(cards, bit(id)));
+}
+
+inline V lowest(V cards) {
+  return highest(bit_and(cards, sub(set(0), cards)));
+}
+
+inline V trump_mask(V trump) {
+  return bit_or(shl(set(SUIT0), trump), bit(left_bower(trump)));
+}
+
+inline V suit_mask(V suit, V trump) {
+  const V plain = and_not(shl(set(SUIT0), suit), bit(left_bower(trump)));
+  return select(eq(suit, trump), trump_mask(trump), plain);
+}
+
+inline V suit_of(V id, V trump) {
+  return select(eq(id, left_bower(trump)), trump, bit_and(id, set(3)));
+}
+
+inline V highest_trump(V cards, V trump) {
+  const V right = right_bower(trump);
+  const V left = left_bower(trump);
+  return select(has(cards, right), right,
+                select(has(cards, left), left, highest(cards)));
+}
+
+inline V lowest_trump(V cards, V trump) {
+  const V right = right_bower(trump);
+  const V left = left_bower(trump);
+  const V plain = and_not(cards, bit_or(bit(right), bit(left)));
+  return select(nonzero(plain), lowest(plain),
+                select(has(cards, left), left, right));
+}
+
+inline V discard_card(V hand, V trump) {
+  const V plain = and_not(hand, trump_mask(trump));
+  return select(nonzero(plain), lowest(plain), lowest_trump(hand, trump));
+}
+
+inline V lead_card(V hand, V trump) {
+  const V plain = and_not(hand, trump_mask(trump));
+  return select(nonzero(plain), highest(plain), highest_trump(hand, trump));
+}
+
+inline V follow_card(V hand, V led, V trump) {
+  const V follow = bit_and(hand, suit_mask(led, trump));
+  const V top = select(eq(led, trump), highest_trump(follow, trump),
+                       highest(follow));
+  return select(nonzero(follow), top, discard_card(hand, trump));
+}
+
+// the trumps of rank Jack or higher in hand, the left bower included,
+// counted without a popcount instruction
+inline V trump_faces(V hand, V trump) {
+  const V one = set(1);
+  const V own = shr(hand, trump);   // trump's cards moved to suit 0
+  V count = bit_and(shr(hand, left_bower(trump)), one);
+  for (int rank = JACK; rank <= ACE; ++rank) {
+    count = add(count, bit_and(shr(own, set(rank * 4)), one));
+  }
+  return count;
+}
+
+inline M orders_up(V hand, V trump, int round, M is_dealer) {
+  const V faces = trump_faces(hand, trump);
+  return (round == 1) ? gt(faces, set(1)) : either(gt(faces, set(0)), is_dealer);
+}
+
+// A strength of card id in a trick: bowers, then trump, then the suit
+// led, each by rank.  Only how it compares with the other cards of the
+// trick matters, so it need not match CARD_ORDER.
+inline V strength(V id, V led, V trump) {
+  const V suit = bit_and(id, set(3));
+  const V rank = shr(id, set(2));
+  V s = select(eq(suit, led), add(rank, set(16)), rank);
+  s = select(eq(suit, trump), add(rank, set(32)), s);
+  s = select(eq(id, left_bower(trump)), set(62), s);
+  return select(eq(id, right_bower(trump)), set(63), s);
+}
+
+// the hand of each lane's seat
+inline V pick(const V hands[4], V seat) {
+  V hand = hands[0];
+  for (int k = 1; k < 4; ++k) {
+    hand = select(eq(seat, set(k)), hands[k], hand);
+  }
+  return hand;
+}
+
+// takes card id out of the hand of each lane's seat
+inline void remove(V hands[4], V seat, V id) {
+  const V card = bit(id);
+  for (int k = 0; k < 4; ++k) {
+    hands[k] = select(eq(seat, set(k)), and_not(hands[k], card), hands[k]);
+  }
+}
+
+template <class View>
+void make_trump(const View &lanes) {
+  V hands[4];
+  for (int k = 0; k < 4; ++k) {
+    hands[k] = load(lanes.hands[k]);
+  }
+  const V dealer = load(lanes.dealer);
+  const V upcard = load(lanes.upcard);
+  const V up_suit = bit_and(upcard, set(3));
+  V trump = load(lanes.trump);
+  V who = set(-1);
+  for (int round = 1; round <= 2; ++round) {
+    const V suit = (round == 1) ? up_suit : bit_xor(up_suit, set(2));
+    for (int i = 1; i <= 4; ++i) {
+      const V seat = bit_and(add(dealer, set(i)), set(3));
+      const M yes = orders_up(pick(hands, seat), suit, round, eq(seat, dealer));
+      const M take = both(yes, eq(who, set(-1)));
+      trump = select(take, suit, trump);
+      who = select(take, seat, who);
+    }
+    if (round == 1) {
+      // the dealer picks up if trump was made in the first round
+      const V held = bit_or(pick(hands, dealer), bit(upcard));
+      const V kept = and_not(held, bit(discard_card(held, up_suit)));
+      const V picked = select(gt(who, set(-1)), kept, pick(hands, dealer));
+      for (int k = 0; k < 4; ++k) {
+        hands[k] = select(eq(dealer, set(k)), picked, hands[k]);
+      }
+    }
+  }
+  for (int k = 0; k < 4; ++k) {
+    store(lanes.hands[k], hands[k]);
+  }
+  store(lanes.trump, trump);
+  store(lanes.maker, who);
+}
+
+template <class View>
+void play_trick(const View &lanes) {
+  V hands[4];
+  for (int k = 0; k < 4; ++k) {
+    hands[k] = load(lanes.hands[k]);
+  }
+  const V trump = load(lanes.trump);
+  const V leader = load(lanes.leader);
+  V id = lead_card(pick(hands, leader), trump);
+  remove(hands, leader, id);
+  const V led = suit_of(id, trump);
+  V best = strength(id, led, trump);
+  V winner = leader;
+  for (int pos = 1; pos < 4; ++pos) {
+    const V seat = bit_and(add(leader, set(pos)), set(3));
+    id = follow_card(pick(hands, seat), led, trump);
+    remove(hands, seat, id);
+    const V s = strength(id, led, trump);
+    winner = select(gt(s, best), seat, winner);
+    best = select(gt(s, best), s, best);
+  }
+  for (int k = 0; k < 4; ++k) {
+    store(lanes.hands[k], hands[k]);
+  }
+  const V odd = bit_and(winner, set(1));
+  store(lanes.tricks[0], add(load(lanes.tricks[0]), bit_xor(odd, set(1))));
+  store(lanes.tricks[1], add(load(lanes.tricks[1]), odd));
+  store(lanes.leader, winner);
+}
+
+} // namespace simd
+
+#endif // BATCH_SIMD
+
+template <int LANES>
+struct SimpleGameBatch<LANES>::LaneView {
+  uint64_t *hands[4];
+  int64_t *dealer;
+  int64_t *upcard;
+  int64_t *trump;
+  int64_t *maker;
+  int64_t *leader;
+  int64_t *tricks[2];
+};
+
+template <int LANES>
+SimpleGameBatch<LANES>::SimpleGameBatch(const Pack &gamePack, bool shuffleCards,
+                                        int winPoints)
+  : start_pack(gamePack), shuffle(shuffleCards), win_points(winPoints) {
+  assert(win_points > 0);
+}
+
+template <int LANES>
+void SimpleGameBatch<LANES>::play(long count, const uint64_t *seeds,
+                                  GameResult *results) {
+  for (int lane = 0; lane < LANES; ++lane) {
+    // idle lanes still play hands, so give them a valid game
+    start(lane, -1, nullptr);
+    active[lane] = false;
+  }
+  long next = 0;
+  while (true) {
+    // a lane whose game is over starts the next one straight away
+    bool going = false;
+    for (int lane = 0; lane < LANES; ++lane) {
+      if (!active[lane] && next < count) {
+        start(lane, next, seeds ? &seeds[next] : nullptr);
+        ++next;
+      }
+      going = going || active[lane];
+    }
+    if (!going) {
+      break;
+    }
+    deal();
+    make_trump();
+    for (int trick = 0; trick < 5; ++trick) {
+      play_trick();
+    }
+    score();
+    for (int lane = 0; lane < LANES; ++lane) {
+      if (game[lane] >= 0 && !active[lane]) {
+        finish(lane, results[game[lane]]);
+        game[lane] = -1;
+      }
+    }
+  }
+}
+
+template <int LANES>
+void SimpleGameBatch<LANES>::start(int lane, long index, const uint64_t *seed) {
+  game[lane] = index;
+  active[lane] = true;
+  packs[lane] = start_pack;
+  random_shuffle[lane] = (seed != nullptr);
+  if (seed) {
+    rngs[lane].reseed(*seed);
+  }
+  dealer[lane] = 0;
+  trump[lane] = SPADES;
+  hands_played[lane] = 0;
+  for (int team = 0; team < 2; ++team) {
+    points[team][lane] = marches[team][lane] = euchres[team][lane] = 0;
+  }
+}
+
+template <int LANES>
+void SimpleGameBatch<LANES>::finish(int lane, GameResult &result) const {
+  for (int team = 0; team < 2; ++team) {
+    result.points[team] = points[team][lane];
+    result.marches[team] = marches[team][lane];
+    result.euchres[team] = euchres[team][lane];
+  }
+  result.hands_played = hands_played[lane];
+  result.winner = (points[0][lane] >= win_points) ? 0 : 1;
+}
+
+template <int LANES>
+void SimpleGameBatch<LANES>::deal() {
+  // shuffling and dealing go a card at a time, as in BasicEuchreGame
+  for (int lane = 0; lane < LANES; ++lane) {
+    Pack &pack = packs[lane];
+    if (random_shuffle[lane] && active[lane]) {
+      pack.shuffle(rngs[lane]);
+    } else if (shuffle && active[lane]) {
+      pack.shuffle();
+    } else {
+      pack.reset();
+    }
+    for (int seat = 0; seat < 4; ++seat) {
+      hands[seat][lane] = 0;
+    }
+    // three, two, three, two round the table, then two, three, two, three
+    for (int round = 0; round < 2; ++round) {
+      for (int i = 1; i <= 4; ++i) {
+        const int seat = (dealer[lane] + i) % 4;
+        const int n = ((i % 2 == 1) == (round == 0)) ? 3 : 2;
+        for (int k = 0; k < n; ++k) {
+          hands[seat][lane] |= bit(Card_id(pack.deal_one()));
+        }
+      }
+    }
+    upcard[lane] = Card_id(pack.deal_one());
+    leader[lane] = (dealer[lane] + 1) % 4;
+    tricks[0][lane] = tricks[1][lane] = 0;
+  }
+}
+
+template <int LANES>
+typename SimpleGameBatch<LANES>::LaneView
+SimpleGameBatch<LANES>::lanes_from(int first) {
+  LaneView lanes;
+  for (int seat = 0; seat < 4; ++seat) {
+    lanes.hands[seat] = hands[seat] + first;
+  }
+  lanes.dealer = dealer + first;
+  lanes.upcard = upcard + first;
+  lanes.trump = trump + first;
+  lanes.maker = maker + first;
+  lanes.leader = leader + first;
+  lanes.tricks[0] = tricks[0] + first;
+  lanes.tricks[1] = tricks[1] + first;
+  return lanes;
+}
+
+template <int LANES>
+void SimpleGameBatch<LANES>::make_trump() {
+  int lane = 0;
+#ifdef BATCH_SIMD
+  for (; lane + simd::WIDTH <= LANES; lane += simd::WIDTH) {
+    simd::make_trump(lanes_from(lane));
+  }
+#endif
+  for (; lane < LANES; ++lane) {
+    make_trump_lane(lane);
+  }
+}
+
+template <int LANES>
+void SimpleGameBatch<LANES>::make_trump_lane(int lane) {
+  const int d = dealer[lane];
+  const int up_suit = upcard[lane] & 3;
+  int who = -1;
+  for (int round = 1; round <= 2; ++round) {
+    const int suit = (round == 1) ? up_suit : (up_suit ^ 2);
+    for (int i = 1; i <= 4; ++i) {
+      const int seat = (d + i) % 4;
+      const bool yes = orders_up(hands[seat][lane], suit, round, seat == d);
+      trump[lane] = (who < 0 && yes) ? suit : trump[lane];
+      who = (who < 0 && yes) ? seat : who;
+    }
+    if (round == 1) {
+      // the dealer picks up if trump was made in the first round
+      const uint64_t held = hands[d][lane] | bit(upcard[lane]);
+      const uint64_t kept = held & ~bit(discard_card(held, up_suit));
+      hands[d][lane] = (who >= 0) ? kept : hands[d][lane];
+    }
+  }
+  maker[lane] = who;
+}
+
+template <int LANES>
+void SimpleGameBatch<LANES>::play_trick() {
+  int lane = 0;
+#ifdef BATCH_SIMD
+  for (; lane + simd::WIDTH <= LANES; lane += simd::WIDTH) {
+    simd::play_trick(lanes_from(lane));
+  }
+#endif
+  for (; lane < LANES; ++lane) {
+    play_trick_lane(lane);
+  }
+}
+
+template <int LANES>
+void SimpleGameBatch<LANES>::play_trick_lane(int lane) {
+  const int t = trump[lane];
+  int seat = leader[lane];
+  int id = lead_card(hands[seat][lane], t);
+  hands[seat][lane] &= ~bit(id);
+  const int led = suit_of(id, t);
+  int best = CARD_ORDER.value[t][led][id >> 2][id & 3];
+  int winner = seat;
+  for (int pos = 1; pos < 4; ++pos) {
+    seat = (leader[lane] + pos) % 4;
+    id = follow_card(hands[seat][lane], led, t);
+    hands[seat][lane] &= ~bit(id);
+    const int s = CARD_ORDER.value[t][led][id >> 2][id & 3];
+    winner = (s > best) ? seat : winner;
+    best = (s > best) ? s : best;
+  }
+  ++tricks[winner % 2][lane];
+  leader[lane] = winner;
+}
+
+template <int LANES>
+void SimpleGameBatch<LANES>::score() {
+  for (int lane = 0; lane < LANES; ++lane) {
+    // the team that took the most tricks wins the hand
+    const int on = active[lane] ? 1 : 0;
+    const int won = (tricks[0][lane] > tricks[1][lane]) ? 0 : 1;
+    const bool euchred = (won != maker[lane] % 2);
+    const bool march = !euchred && tricks[won][lane] == 5;
+    points[won][lane] += on * ((euchred || march) ? 2 : 1);
+    euchres[won][lane] += on * euchred;
+    marches[won][lane] += on * march;
+    hands_played[lane] += on;
+    dealer[lane] = (dealer[lane] + on) % 4;
+    active[lane] = active[lane] && points[0][lane] < win_points &&
+                   points[1][lane] < win_points;
+  }
+}
+
+// the batch sizes in use; other translation units only see declarations
+template class SimpleGameBatch<8>;
+template class SimpleGameBatch<16>;
+template class SimpleGameBatch<32>;
@@ -0,0 +1,114 @@
+#ifndef SIMPLEBATCH_HPP
+#define SIMPLEBATCH_HPP
+/* SimpleBatch.hpp
+ *
+ * Plays several all-Simple games at once, in lockstep.  The state of the
+ * games is stored as structure of arrays, one array element ("lane") per
+ * game: hands are 64-bit card bitmasks, and the dealer, upcard, trump,
+ * maker, leader and tricks are 64-bit integers too, so one SIMD register
+ * holds the same lanes of every array.  Every step of a hand (deal, bid,
+ * discard, each play of each trick, scoring) is one pass over the lanes.
+ *
+ * Bidding, the dealer's discard and trick play, where the Simple strategy
+ * spends its time, have hand-written SIMD paths.  The strategy's choices
+ * are mask arithmetic and per-lane selects, and bit scans turn into
+ * leading-zero counts.  The paths are chosen at compile time:
+ *   AVX-512 (__AVX512F__ and __AVX512CD__): 8 lanes per instruction
+ *   AVX2 (__AVX2__): 4 lanes per instruction
+ *   otherwise: one lane at a time, with no branches on the cards
+ * The default build uses portable flags and so takes the last path; build
+ * with -mavx2, -mavx512f -mavx512cd or a -march that has them for the
+ * others.  Shuffling and dealing always go one lane at a time, since each
+ * lane's shuffle is a chain of random draws, as in BasicEuchreGame.
+ *
+ * Each game produces the same result as SimpleEuchreGame on the same pack
+ * with the same shuffling.  Games last different numbers of hands, so a
+ * lane whose game is over starts the next game at once; lanes only play
+ * dummy hands once no games are left to start.
+ */
+
+
+#include "Game.hpp"
+#include "Pack.hpp"
+#include "Random.hpp"
+#include <cstdint>
+
+template <int LANES>
+class SimpleGameBatch {
+  static_assert(LANES > 0, "a batch needs at least one lane");
+
+public:
+  //REQUIRES winPoints > 0
+  //EFFECTS Initializes a batch whose games each start from a copy of
+  //  gamePack, are shuffled as BasicEuchreGame shuffles with shuffleCards,
+  //  and are played to winPoints
+  SimpleGameBatch(const Pack &gamePack, bool shuffleCards, int winPoints);
+
+  //REQUIRES results has room for count results, and so does seeds if
+  //  it is not null
+  //EFFECTS Plays count games, LANES at a time, and stores the result of
+  //  game i in results[i].  If seeds is not null, game i is shuffled as
+  //  if use_random_shuffle had been called with seeds[i].
+  void play(long count, const std::uint64_t *seeds, GameResult *results);
+
+private:
+  Pack start_pack;
+  bool shuffle;
+  int win_points;
+
+  // per-lane state; game lane's values are element [lane]
+  Pack packs[LANES];
+  Rng rngs[LANES];
+  bool random_shuffle[LANES];
+  long game[LANES];             // index of the game in the lane, or -1
+  bool active[LANES];           // game not yet over
+  std::uint64_t hands[4][LANES];
+  std::int64_t dealer[LANES];
+  std::int64_t upcard[LANES];   // Card_id of the upcard
+  std::int64_t trump[LANES];
+  std::int64_t maker[LANES];
+  std::int64_t leader[LANES];   // player to lead the next trick
+  std::int64_t tricks[2][LANES];
+  int points[2][LANES];
+  int marches[2][LANES];
+  int euchres[2][LANES];
+  int hands_played[LANES];
+
+  // EFFECTS: Sets lane up to play game index, shuffled with seed if it
+  //          is not null
+  void start(int lane, long index, const std::uint64_t *seed);
+
+  // EFFECTS: Stores the result of lane's finished game in result
+  void finish(int lane, GameResult &result) const;
+
+  // EFFECTS: Shuffles and deals the next hand in every lane
+  void deal();
+
+  // EFFECTS: Runs both rounds of making trump, and the dealer's pick up
+  void make_trump();
+
+  // EFFECTS: Plays one trick in every lane
+  void play_trick();
+
+  // EFFECTS: Runs make_trump in lane alone
+  void make_trump_lane(int lane);
+
+  // EFFECTS: Runs play_trick in lane alone
+  void play_trick_lane(int lane);
+
+  // The per-lane arrays from one lane on, for a SIMD pass over them
+  struct LaneView;
+
+  // EFFECTS: Returns the arrays from lane first on
+  LaneView lanes_from(int first);
+
+  // EFFECTS: Scores the hand and marks games that are over inactive
+  void score();
+};
+
+// the batch sizes in use; other sizes need an instantiation in SimpleBatch.cpp
+using SimpleGameBatch8 = SimpleGameBatch<8>;
+using SimpleGameBatch16 = SimpleGameBatch<16>;
+using SimpleGameBatch32 = SimpleGameBatch<32>;
+
+#endif // SIMPLEBATCH_HPP
@@ -0,0 +1,83 @@
+#include "SimpleBatch.hpp"
+#include "Game.hpp"
+#include "Pack.hpp"
+#include "Random.hpp"
+#include "SimplePlayer.hpp"
+#include "unit_test_framework.hpp"
+
+#include <fstream>
+#include <vector>
+
+using namespace std;
+
+// Plays one game with SimpleEuchreGame, the engine the batch must match
+static GameResult play_single(const Pack &pack, bool shuffle, int points,
+                              const uint64_t *seed) {
+    SimplePlayer seats[4] = {SimplePlayer("A"), SimplePlayer("B"),
+                             SimplePlayer("C"), SimplePlayer("D")};
+    vector<SimplePlayer*> players = {&seats[0], &seats[1], &seats[2], &seats[3]};
+    SimpleEuchreGame game(pack, shuffle, points, players, nullptr);
+    if (seed) {
+        game.use_random_shuffle(*seed);
+    }
+    return game.startGame();
+}
+
+static void assert_same(const GameResult &a, const GameResult &b) {
+    ASSERT_EQUAL(a.points[0], b.points[0]);
+    ASSERT_EQUAL(a.points[1], b.points[1]);
+    ASSERT_EQUAL(a.marches[0], b.marches[0]);
+    ASSERT_EQUAL(a.marches[1], b.marches[1]);
+    ASSERT_EQUAL(a.euchres[0], b.euchres[0]);
+    ASSERT_EQUAL(a.euchres[1], b.euchres[1]);
+    ASSERT_EQUAL(a.hands_played, b.hands_played);
+    ASSERT_EQUAL(a.winner, b.winner);
+}
+
+// Plays random games, fewer and more than fill the batch, and checks each
+// game against the single-game engine
+template <int LANES>
+static void check_random_games(int points) {
+    SimpleGameBatch<LANES> batch(Pack(), false, points);
+    const long counts[] = {1, LANES - 1, 5 * LANES + 3};
+    for (long count : counts) {
+        vector<uint64_t> seeds(count);
+        vector<GameResult> results(count);
+        for (long i = 0; i < count; ++i) {
+            seeds[i] = Rng::game_seed(points + count, i);
+        }
+        batch.play(count, seeds.data(), results.data());
+        for (long i = 0; i < count; ++i) {
+            assert_same(results[i], play_single(Pack(), false, points, &seeds[i]));
+        }
+    }
+}
+
+TEST(test_batch_random_8) {
+    check_random_games<8>(10);
+}
+
+TEST(test_batch_random_16) {
+    check_random_games<16>(5);
+}
+
+TEST(test_batch_random_32) {
+    check_random_games<32>(15);
+}
+
+// The in shuffle and no shuffle deal every game alike, from the pack given
+TEST(test_batch_in_shuffle_and_no_shuffle) {
+    ifstream pack_in("pack.in");
+    Pack pack(pack_in);
+    for (int shuffle = 0; shuffle < 2; ++shuffle) {
+        GameResult expected = play_single(pack, shuffle, 10, nullptr);
+        SimpleGameBatch8 batch(pack, shuffle, 10);
+        GameResult results[12];
+        batch.play(12, nullptr, results);
+        for (const GameResult &result : results) {
+            assert_same(result, expected);
+        }
+    }
+}
+
+TEST_MAIN()
@@ -0,0 +1,129 @@
+#ifndef SIMPLEPLAYER_HPP
+#define SIMPLEPLAYER_HPP
+/* SimplePlayer.hpp
+ *
+ * The "Simple" computer strategy.  The class is final and defined in
+ * this header so code that holds a SimplePlayer directly, such as
+ * SimpleEuchreGame, calls it without virtual dispatch and can inline it.
+ *
+ * The strategy's decisions are also free functions of the hand, so
+ * other players that fall back on the Simple strategy, such as
+ * SearchPlayer, make exactly the same ones.
+ */
+
+
+#include "Player.hpp"
+#include "CardSet.hpp"
+#include <cassert>
+#include <string>
+
+//REQUIRES round is 1 or 2
+//EFFECTS Returns the suit the Simple strategy would order up in round:
+//  the upcard's suit in round 1, and the other suit of its color in 2
+inline Suit Simple_bid_suit(const Card &upcard, int round) {
+  assert(round == 1 || round == 2);
+  return (round == 1) ? upcard.get_suit() : Suit_next(upcard.get_suit());
+}
+
+//REQUIRES round is 1 or 2
+//EFFECTS Returns true if the Simple strategy holding hand orders up
+//  Simple_bid_suit(upcard, round): with two trump faces in round 1, and
+//  with one in round 2, where the dealer always orders up
+inline bool Simple_orders_up(CardSet hand, const Card &upcard, bool is_dealer,
+                             int round) {
+  const Suit trump = Simple_bid_suit(upcard, round);
+  const int face_card_count = (hand & CardSet::trump_cards(trump)
+                               & CardSet::face_or_ace_cards()).size();
+  return (round == 1 && face_card_count >= 2) ||
+         (round == 2 && (face_card_count >= 1 || is_dealer));
+}
+
+//REQUIRES hand is not empty
+//EFFECTS Returns the card the Simple strategy throws away after picking
+//  up upcard: the lowest of hand and upcard, with upcard's suit trump
+inline Card Simple_discard(CardSet hand, const Card &upcard) {
+  hand.add(upcard);
+  return hand.lowest(upcard.get_suit());
+}
+
+//REQUIRES hand is not empty
+//EFFECTS Returns the card the Simple strategy leads: its highest
+//  non-trump, or its highest trump if it has only trumps
+inline Card Simple_lead(CardSet hand, Suit trump) {
+  const CardSet non_trump = hand.without(CardSet::trump_cards(trump));
+  return non_trump.empty() ? hand.highest(trump) : non_trump.highest();
+}
+
+//REQUIRES hand is not empty
+//EFFECTS Returns the card the Simple strategy plays after led_card: its
+//  highest card of the led suit, or its lowest card if it cannot follow
+inline Card Simple_follow(CardSet hand, const Card &led_card, Suit trump) {
+  const Suit led_suit = led_card.get_suit(trump);
+  const CardSet follow = hand & CardSet::suit_cards(led_suit, trump);
+  return follow.empty() ? hand.lowest(led_suit, trump)
+                        : follow.highest(led_suit, trump);
+}
+
+class SimplePlayer final : public Player {
+private:
+  std::string name;            // 玩家姓名
+  CardSet hand;                // 玩家手牌，每张牌占一位
+
+public:
+  // 构造函数，使用给定的姓名初始化玩家
+  SimplePlayer(const std::string& name_in) : name(name_in) {}
+
+  // 返回玩家的姓名
+  const std::string& get_name() const override {
+    return name;
+  }
+
+  // 向玩家手牌中添加一张牌
+  void add_card(const Card& c) override {
+    assert(hand.size() < MAX_HAND_SIZE);
+    hand.add(c);
+  }
+
+  // 玩家决定是否叫主
+  bool make_trump(const Card& upcard, bool is_dealer,
+                  int round, Suit& order_up_suit) const override {
+    // 第一轮需要两张高牌，第二轮一张即可；第二轮庄家强制叫主
+    if (!Simple_orders_up(hand, upcard, is_dealer, round)) {
+      return false;
+    }
+    order_up_suit = Simple_bid_suit(upcard, round);
+    return true;
+  }
+
+  // 庄家加牌并弃牌
+  void add_and_discard(const Card& upcard) override {
+    assert(hand.size() >= 1);
+    // 弃掉手牌和翻开的牌中最小的牌
+    const Card discard = Simple_discard(hand, upcard);
+    hand.add(upcard);
+    hand.remove(discard);
+  }
+
+  // 领先出牌
+  Card lead_card(Suit trump) override {
+    assert(hand.size() >= 1);
+    // 如果有非主牌，出最大的非主牌；否则出最大的主牌
+    Card lead = Simple_lead(hand, trump);
+    hand.remove(lead);
+    return lead;
+  }
+
+  // 跟牌
+  Card play_card(const Card& led_card, Suit trump) override {
+    assert(hand.size() >= 1);
+    // 如果有跟出的花色，出最大的那张；否则，出最小的牌
+    Card play = Simple_follow(hand, led_card, trump);
+    hand.remove(play);
+    return play;
+  }
+
+  // 析构函数
+  ~SimplePlayer() override = default;
+};
+
+#endif // SIMPLEPLAYER_HPP
@@ -0,0 +1,164 @@
+#include "Tournament.hpp"
+#include "Game.hpp"
+#include "Player.hpp"
+#include "Random.hpp"
+#include "SimpleBatch.hpp"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// games claimed by a worker at a time; large enough that the shared
+// counter is touched rarely, small enough to balance the tail
+static const long CHUNK_SIZE = 64;
+
+double TournamentResult::win_rate(int team) const {
+  if (games == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(wins[team]) / games;
+}
+
+void TournamentResult::merge(const TournamentResult &other) {
+  games += other.games;
+  hands_played += other.hands_played;
+  for (int team = 0; team < 2; ++team) {
+    wins[team] += other.wins[team];
+    points[team] += other.points[team];
+    marches[team] += other.marches[team];
+    euchres[team] += other.euchres[team];
+  }
+}
+
+// Plays game number index headless with a fresh pack and players, and
+// appends its hands to records if that is not null
+static GameResult play_one(const TournamentConfig &config, long index,
+                           vector<HandRecord> *records) {
+  vector<Player*> players;
+  for (int seat = 0; seat < 4; ++seat) {
+    players.push_back(Player_factory("Player" + to_string(seat),
+                                     config.strategies[seat]));
+  }
+  EuchreGame game(config.pack, config.shuffle, config.points_to_win,
+                  players, nullptr);
+  if (config.random_shuffle) {
+    game.use_random_shuffle(Rng::game_seed(config.seed, index));
+  }
+  if (records) {
+    game.set_record(records, static_cast<uint32_t>(index));
+  }
+  GameResult result = game.startGame();
+  for (Player *p : players) {
+    delete p;
+  }
+  return result;
+}
+
+// Returns true if every seat plays the Simple strategy
+static bool all_simple(const TournamentConfig &config) {
+  for (const string &strategy : config.strategies) {
+    if (strategy != "Simple") {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Adds the result of one game to total
+static void add_game(TournamentResult &total, const GameResult &game) {
+  total.games++;
+  total.wins[game.winner]++;
+  total.hands_played += game.hands_played;
+  for (int team = 0; team < 2; ++team) {
+    total.points[team] += game.points[team];
+    total.marches[team] += game.marches[team];
+    total.euchres[team] += game.euchres[team];
+  }
+}
+
+// Same as play_one for games begin..end-1 of an all-Simple table, played
+// side by side in lockstep
+static void play_simple_games(const TournamentConfig &config, long begin,
+                              long end, TournamentResult &total) {
+  uint64_t seeds[CHUNK_SIZE];
+  GameResult results[CHUNK_SIZE];
+  const long count = end - begin;
+  for (long i = 0; i < count; ++i) {
+    seeds[i] = Rng::game_seed(config.seed, begin + i);
+  }
+  SimpleGameBatch16 batch(config.pack, config.shuffle, config.points_to_win);
+  batch.play(count, config.random_shuffle ? seeds : nullptr, results);
+  for (long i = 0; i < count; ++i) {
+    add_game(total, results[i]);
+  }
+}
+
+// Worker loop: claims chunks of games from next until none remain and
+// accumulates into a thread-local total and stats
+static void run_worker(const TournamentConfig &config, atomic<long> &next,
+                       TournamentResult &total, GameStats &stats) {
+  TournamentResult local;
+  GameStats local_stats;
+  const bool keep_records = config.record || config.stats;
+  // the lockstep batch keeps no record of the play
+  const bool simple = all_simple(config) && !keep_records;
+  vector<HandRecord> records;
+  vector<HandRecord> *chunk_records = keep_records ? &records : nullptr;
+  while (true) {
+    long begin = next.fetch_add(CHUNK_SIZE, memory_order_relaxed);
+    if (begin >= config.games) {
+      break;
+    }
+    long end = min(begin + CHUNK_SIZE, config.games);
+    if (simple) {
+      play_simple_games(config, begin, end, local);
+      continue;
+    }
+    for (long i = begin; i < end; ++i) {
+      add_game(local, play_one(config, i, chunk_records));
+    }
+    if (config.stats) {
+      for (const HandRecord &record : records) {
+        local_stats.add_hand(record);
+      }
+    }
+    if (config.record) {
+      config.record->write(records);
+    }
+    records.clear();
+  }
+  total = local;
+  stats = local_stats;
+}
+
+TournamentResult run_tournament(const TournamentConfig &config) {
+  int threads = config.threads;
+  if (threads <= 0) {
+    threads = max(1u, thread::hardware_concurrency());
+  }
+
+  atomic<long> next(0);
+  vector<TournamentResult> totals(threads);
+  vector<GameStats> stats(threads);
+  vector<thread> workers;
+  for (int t = 1; t < threads; ++t) {
+    workers.emplace_back(run_worker, cref(config), ref(next),
+                         ref(totals[t]), ref(stats[t]));
+  }
+  // the calling thread works too
+  run_worker(config, next, totals[0], stats[0]);
+  for (thread &worker : workers) {
+    worker.join();
+  }
+
+  TournamentResult result;
+  for (int t = 0; t < threads; ++t) {
+    result.merge(totals[t]);
+    if (config.stats) {
+      config.stats->merge(stats[t]);
+    }
+  }
+  return result;
+}
@@ -0,0 +1,52 @@
+#ifndef TOURNAMENT_HPP
+#define TOURNAMENT_HPP
+/* Tournament.hpp
+ *
+ * Runs many independent euchre games in parallel
+ */
+
+
+#include "GameRecord.hpp"
+#include "GameStats.hpp"
+#include "Pack.hpp"
+#include <cstdint>
+#include <string>
+
+struct TournamentConfig {
+  Pack pack;                    // every game starts from a copy of this pack
+  bool shuffle = false;
+  bool random_shuffle = false;  // overrides shuffle
+  std::uint64_t seed = 0;       // game i is seeded with Rng::game_seed(seed, i)
+  int points_to_win = 10;
+  long games = 0;
+  std::string strategies[4];    // Player_factory strategy for each seat
+  int threads = 0;              // 0 means one per hardware thread
+  GameRecordWriter *record = nullptr;  // if set, every hand is written here
+  GameStats *stats = nullptr;          // if set, every hand is counted here
+};
+
+// Totals over all games.  Arrays are indexed by team as in GameResult.
+struct TournamentResult {
+  long games = 0;
+  long wins[2] = {0, 0};
+  long points[2] = {0, 0};
+  long marches[2] = {0, 0};
+  long euchres[2] = {0, 0};
+  long hands_played = 0;
+
+  //EFFECTS Returns the fraction of games won by team
+  double win_rate(int team) const;
+
+  //EFFECTS Adds the totals in other to this result
+  void merge(const TournamentResult &other);
+};
+
+//REQUIRES config.strategies are all computer strategies, and
+//  config.points_to_win is at most MAX_RECORDED_POINTS if config.record
+//  or config.stats is set
+//EFFECTS Plays config.games headless games spread across config.threads
+//  worker threads and returns the combined result.  Each game gets its
+//  own Pack and players from Player_factory.
+TournamentResult run_tournament(const TournamentConfig &config);
+
+#endif // TOURNAMENT_HPP
@@ -0,0 +1,157 @@
+#include "Tournament.hpp"
+#include "Game.hpp"
+#include "Pack.hpp"
+#include "Player.hpp"
+#include "Random.hpp"
+#include "unit_test_framework.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+using namespace std;
+
+static TournamentConfig simple_config(long games, int threads) {
+    TournamentConfig config;
+    config.shuffle = true;
+    config.points_to_win = 10;
+    config.games = games;
+    config.threads = threads;
+    for (int seat = 0; seat < 4; ++seat) {
+        config.strategies[seat] = "Simple";
+    }
+    return config;
+}
+
+// Every game is played exactly once no matter how many threads
+TEST(test_tournament_game_count) {
+    TournamentResult result = run_tournament(simple_config(1000, 4));
+    ASSERT_EQUAL(result.games, 1000);
+    ASSERT_EQUAL(result.wins[0] + result.wins[1], 1000);
+}
+
+// Parallel totals match a single thread
+TEST(test_tournament_threads_agree) {
+    TournamentResult one = run_tournament(simple_config(300, 1));
+    TournamentResult many = run_tournament(simple_config(300, 8));
+    ASSERT_EQUAL(one.wins[0], many.wins[0]);
+    ASSERT_EQUAL(one.points[1], many.points[1]);
+    ASSERT_EQUAL(one.hands_played, many.hands_played);
+    ASSERT_EQUAL(one.euchres[0], many.euchres[0]);
+}
+
+// A game too long to record plays when nothing is recorded, away from
+// the Simple-only batch too
+TEST(test_tournament_long_game_unrecorded) {
+    TournamentConfig config = simple_config(1, 1);
+    config.points_to_win = MAX_RECORDED_POINTS + 1;
+    config.strategies[3] = "MonteCarlo:1";
+    TournamentResult result = run_tournament(config);
+    ASSERT_EQUAL(result.games, 1);
+    ASSERT_TRUE(max(result.points[0], result.points[1]) > MAX_RECORDED_POINTS);
+}
+
+// Totals agree with playing the same game directly
+TEST(test_tournament_matches_game) {
+    vector<Player*> players;
+    for (int seat = 0; seat < 4; ++seat) {
+        players.push_back(Player_factory("Player", "Simple"));
+    }
+    EuchreGame game(Pack(), true, 10, players, nullptr);
+    GameResult single = game.startGame();
+    for (Player *p : players) {
+        delete p;
+    }
+
+    TournamentResult result = run_tournament(simple_config(10, 2));
+    ASSERT_EQUAL(result.wins[single.winner], 10);
+    ASSERT_EQUAL(result.points[0], 10 * single.points[0]);
+    ASSERT_EQUAL(result.hands_played, 10 * single.hands_played);
+    ASSERT_ALMOST_EQUAL(result.win_rate(single.winner), 1.0, 1e-9);
+}
+
+// Seeded random games give the same totals on any number of threads,
+// and game i can be replayed on its own from its seed
+TEST(test_tournament_random_reproducible) {
+    TournamentConfig config = simple_config(200, 1);
+    config.random_shuffle = true;
+    config.seed = 99;
+    TournamentResult one = run_tournament(config);
+    config.threads = 8;
+    TournamentResult many = run_tournament(config);
+    ASSERT_EQUAL(one.wins[0], many.wins[0]);
+    ASSERT_EQUAL(one.hands_played, many.hands_played);
+    ASSERT_TRUE(one.wins[0] > 0 && one.wins[1] > 0);
+
+    config.games = 1;
+    TournamentResult first = run_tournament(config);
+    vector<Player*> players;
+    for (int seat = 0; seat < 4; ++seat) {
+        players.push_back(Player_factory("Player", "Simple"));
+    }
+    EuchreGame game(Pack(), true, 10, players, nullptr);
+    game.use_random_shuffle(Rng::game_seed(99, 0));
+    GameResult replay = game.startGame();
+    for (Player *p : players) {
+        delete p;
+    }
+    ASSERT_EQUAL(first.hands_played, replay.hands_played);
+    ASSERT_EQUAL(first.points[0], replay.points[0]);
+}
+
+// A recorded tournament writes every hand of every game, each game's
+// hands together, and plays as it would unrecorded
+TEST(test_tournament_record) {
+    TournamentConfig config = simple_config(150, 4);
+    config.random_shuffle = true;
+    config.seed = 5;
+    TournamentResult plain = run_tournament(config);
+    ostringstream out;
+    GameRecordWriter writer(out);
+    config.record = &writer;
+    TournamentResult recorded = run_tournament(config);
+    ASSERT_EQUAL(recorded.hands_played, plain.hands_played);
+    ASSERT_EQUAL(recorded.wins[0], plain.wins[0]);
+
+    // skip the file header
+    const string bytes = out.str().substr(16);
+    ASSERT_EQUAL(bytes.size(), recorded.hands_played * sizeof(HandRecord));
+    vector<HandRecord> records(bytes.size() / sizeof(HandRecord));
+    bytes.copy(reinterpret_cast<char *>(records.data()), bytes.size());
+    vector<int> hands(config.games);
+    for (size_t i = 0; i < records.size(); ++i) {
+        ASSERT_EQUAL(records[i].hand, hands[records[i].game]++);
+        if (i > 0 && records[i].hand > 0) {
+            ASSERT_EQUAL(records[i].game, records[i - 1].game);
+        }
+    }
+}
+
+// A tournament with stats counts every hand it plays, the same way
+// whatever the number of threads
+TEST(test_tournament_stats) {
+    TournamentConfig config = simple_config(120, 3);
+    config.random_shuffle = true;
+    config.seed = 9;
+    GameStats stats;
+    config.stats = &stats;
+    TournamentResult result = run_tournament(config);
+    ASSERT_EQUAL(stats.hands(), result.hands_played);
+    ASSERT_EQUAL(stats.marches(), result.marches[0] + result.marches[1]);
+    ASSERT_EQUAL(stats.euchres(), result.euchres[0] + result.euchres[1]);
+    for (int team = 0; team < 2; ++team) {
+        ASSERT_EQUAL(stats.team_points(team, 1) + 2 * stats.team_points(team, 2),
+                     result.points[team]);
+    }
+
+    GameStats one_thread;
+    config.stats = &one_thread;
+    config.threads = 1;
+    run_tournament(config);
+    ostringstream csv, csv_one_thread;
+    stats.print_csv(csv);
+    one_thread.print_csv(csv_one_thread);
+    ASSERT_EQUAL(csv.str(), csv_one_thread.str());
+}
+
+TEST_MAIN()
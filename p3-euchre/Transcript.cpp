@@ -0,0 +1,79 @@
+#include "Transcript.hpp"
+#include "Instrument.hpp"
+#include <cstring>
+#include <ostream>
+
+using namespace std;
+
+TranscriptWriter::TranscriptWriter(ostream *os)
+  : os(os), line_buffered(false), used(0) {}
+
+TranscriptWriter::~TranscriptWriter() {
+  flush();
+}
+
+void TranscriptWriter::append(const char *data, size_t n) {
+  if (!os) {
+    return;
+  }
+  if (used + n > BUFFER_SIZE) {
+    flush();
+    if (n > BUFFER_SIZE) {
+      os->write(data, n);
+      return;
+    }
+  }
+  memcpy(buffer + used, data, n);
+  used += n;
+  if (line_buffered && memchr(data, '\n', n) != nullptr) {
+    flush();
+  }
+}
+
+void TranscriptWriter::flush() {
+  if (os && used > 0) {
+    INSTRUMENT_PHASE(PHASE_OUTPUT);
+    os->write(buffer, used);
+    used = 0;
+  }
+}
+
+TranscriptWriter & TranscriptWriter::operator<<(string_view text) {
+  append(text.data(), text.size());
+  return *this;
+}
+
+TranscriptWriter & TranscriptWriter::operator<<(char c) {
+  append(&c, 1);
+  return *this;
+}
+
+TranscriptWriter & TranscriptWriter::operator<<(int n) {
+  // digits are produced right to left
+  char digits[12];
+  char *end = digits + sizeof(digits);
+  char *p = end;
+  unsigned magnitude = (n < 0) ? 0u - static_cast<unsigned>(n)
+                               : static_cast<unsigned>(n);
+  do {
+    *--p = static_cast<char>('0' + magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (n < 0) {
+    *--p = '-';
+  }
+  append(p, end - p);
+  return *this;
+}
+
+TranscriptWriter & TranscriptWriter::operator<<(const Card &card) {
+  return *this << Card_name(card);
+}
+
+TranscriptWriter & TranscriptWriter::operator<<(Suit suit) {
+  return *this << Suit_name(suit);
+}
+
+TranscriptWriter & TranscriptWriter::operator<<(Rank rank) {
+  return *this << Rank_name(rank);
+}
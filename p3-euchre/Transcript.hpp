@@ -0,0 +1,57 @@
+#ifndef TRANSCRIPT_HPP
+#define TRANSCRIPT_HPP
+/* Transcript.hpp
+ *
+ * Buffered writer for game transcripts.  Text is formatted straight into
+ * a fixed buffer, with card names taken from Card_name, and handed to the
+ * output stream in large blocks instead of one flush per line.
+ */
+
+
+#include "Card.hpp"
+#include <cstddef>
+#include <iosfwd>
+#include <string_view>
+
+class TranscriptWriter {
+public:
+  static constexpr std::size_t BUFFER_SIZE = 1 << 16;
+
+  // EFFECTS: Initializes a writer that sends its text to os, or throws it
+  //          away if os is null.
+  explicit TranscriptWriter(std::ostream *os);
+
+  // EFFECTS: Flushes any buffered text.
+  ~TranscriptWriter();
+
+  TranscriptWriter(const TranscriptWriter &) = delete;
+  TranscriptWriter & operator=(const TranscriptWriter &) = delete;
+
+  // EFFECTS: Returns true if text is written anywhere.
+  bool enabled() const { return os != nullptr; }
+
+  // EFFECTS: If on, hands text to the stream at the end of every line.
+  //          Use this when something else, such as a HumanPlayer's
+  //          prompts, writes to the same stream.
+  void set_line_buffered(bool on) { line_buffered = on; }
+
+  TranscriptWriter & operator<<(std::string_view text);
+  TranscriptWriter & operator<<(char c);
+  TranscriptWriter & operator<<(int n);
+  TranscriptWriter & operator<<(const Card &card);
+  TranscriptWriter & operator<<(Suit suit);
+  TranscriptWriter & operator<<(Rank rank);
+
+  // EFFECTS: Hands all buffered text to the stream.
+  void flush();
+
+private:
+  std::ostream *os;
+  bool line_buffered;
+  std::size_t used;
+  char buffer[BUFFER_SIZE];
+
+  void append(const char *data, std::size_t n);
+};
+
+#endif // TRANSCRIPT_HPP
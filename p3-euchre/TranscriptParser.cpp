@@ -0,0 +1,360 @@
+#include "TranscriptParser.hpp"
+#include <algorithm>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+namespace {
+
+// the first line of every game, as euchre.exe echoes its command
+const string_view COMMAND = "./euchre.exe ";
+
+// parts of a hand that must all be read before it is complete
+const int SEEN_DEALER = 1;
+const int SEEN_UPCARD = 2;
+const int SEEN_BID = 4;
+const int SEEN_ALL = SEEN_DEALER | SEEN_UPCARD | SEEN_BID;
+
+bool starts_with(string_view text, string_view prefix) {
+  return text.substr(0, prefix.size()) == prefix;
+}
+
+// EFFECTS: If text ends with suffix, drops it and returns true
+bool drop_suffix(string_view &text, string_view suffix) {
+  if (text.size() < suffix.size() ||
+      text.substr(text.size() - suffix.size()) != suffix) {
+    return false;
+  }
+  text.remove_suffix(suffix.size());
+  return true;
+}
+
+// EFFECTS: Returns the next space-separated word of text and drops it
+string_view take_word(string_view &text) {
+  const size_t start = min(text.find_first_not_of(' '), text.size());
+  const size_t end = min(text.find(' ', start), text.size());
+  const string_view word = text.substr(start, end - start);
+  text.remove_prefix(end);
+  return word;
+}
+
+// EFFECTS: If text is a number, sets n to it and returns true
+bool parse_number(string_view text, int &n) {
+  if (text.empty() || text.size() > 9) {
+    return false;
+  }
+  n = 0;
+  for (char c : text) {
+    if (c < '0' || c > '9') {
+      return false;
+    }
+    n = n * 10 + (c - '0');
+  }
+  return true;
+}
+
+} // namespace
+
+TranscriptParser::TranscriptParser()
+  : game_count(0), dropped(0), record(), in_hand(false), bad(false),
+    passes(0), plays(0), tricks(0), scores(0), seen(0) {}
+
+int TranscriptParser::seat_of(string_view name) const {
+  for (int seat = 0; seat < 4; ++seat) {
+    if (!names[seat].empty() && names[seat] == name) {
+      return seat;
+    }
+  }
+  return -1;
+}
+
+void TranscriptParser::finish() {
+  if (in_hand) {
+    ++dropped;
+    in_hand = false;
+  }
+}
+
+void TranscriptParser::start_game(string_view line) {
+  finish();
+  ++game_count;
+  line.remove_prefix(COMMAND.size());
+  // the pack, how it is shuffled and the points to win come first
+  for (int i = 0; i < 3; ++i) {
+    take_word(line);
+  }
+  for (string &name : names) {
+    name = take_word(line);
+    take_word(line);  // the player's strategy
+  }
+}
+
+void TranscriptParser::start_hand(int number) {
+  finish();
+  in_hand = true;
+  record = HandRecord();
+  record.game = game_count - 1;
+  record.hand = number;
+  // a hand before any game's command line has no players to match, and
+  // one past what a record can number is dropped rather than wrapped
+  bad = game_count == 0 || number > UINT16_MAX;
+  passes = plays = tricks = scores = seen = 0;
+}
+
+void TranscriptParser::parse_line(string_view line, vector<HandRecord> &records) {
+  drop_suffix(line, "\r");
+  int number = 0;
+  if (starts_with(line, COMMAND)) {
+    start_game(line);
+  } else if (starts_with(line, "Hand ") && parse_number(line.substr(5), number)) {
+    start_hand(number);
+  } else if (!in_hand) {
+    return;
+  }
+  Card card;
+  string_view rest = line;
+  if (parse_card(rest, card)) {
+    parse_card_line(card, rest);
+  } else if (starts_with(line, COMMAND) || starts_with(line, "Hand ")) {
+    return;
+  } else if (line.find(" have ") != string_view::npos) {
+    parse_score(line, records);
+  } else {
+    parse_player_line(line);
+  }
+}
+
+void TranscriptParser::parse_card_line(const Card &card, string_view rest) {
+  if (rest == " turned up") {
+    record.upcard = Card_euchre_id(card);
+    seen |= SEEN_UPCARD;
+    bad = bad || card.get_rank() < NINE;
+    return;
+  }
+  if (!starts_with(rest, " led by ") && !starts_with(rest, " played by ")) {
+    return;
+  }
+  take_word(rest);
+  take_word(rest);
+  const int seat = seat_of(rest.substr(1));
+  // the seat must be the one due to play, and the card a euchre card
+  if (seat < 0 || plays >= 20 || tricks != plays / 4 ||
+      (seen & SEEN_DEALER) == 0 || seat != record.play_seat(plays) ||
+      card.get_rank() < NINE) {
+    bad = true;
+    return;
+  }
+  record.plays[plays++] = Card_euchre_id(card);
+  record.hands[seat] |= 1u << Card_euchre_id(card);
+}
+
+bool TranscriptParser::parse_player_line(string_view line) {
+  const size_t order = line.find(" orders up ");
+  if (order != string_view::npos) {
+    const int maker = seat_of(line.substr(0, order));
+    Suit trump = SPADES;
+    bad = bad || maker < 0 ||
+          !parse_suit(line.substr(order + 11), trump);
+    // four passes go round the table before round two
+    const int round_bit = passes < 4 ? 0 : 1;
+    record.bid = (record.bid & 3) | (maker & 3) << 2 | trump << 4 | round_bit << 6;
+    seen |= SEEN_BID;
+    return true;
+  }
+  string_view name = line;
+  if (drop_suffix(name, " passes")) {
+    ++passes;
+  } else if (drop_suffix(name, " deals")) {
+    const int dealer = seat_of(name);
+    bad = bad || dealer < 0;
+    record.bid = (record.bid & ~3) | (dealer & 3);
+    seen |= SEEN_DEALER;
+  } else if (drop_suffix(name, " takes the trick")) {
+    const int winner = seat_of(name);
+    bad = bad || winner < 0 || tricks >= 5 || plays != 4 * (tricks + 1);
+    record.winners |= (winner & 3) << (2 * min(tricks, 4));
+    ++tricks;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void TranscriptParser::parse_score(string_view line, vector<HandRecord> &records) {
+  // "<player> and <partner> have <points> points"
+  string_view rest = line;
+  const int seat = seat_of(rest.substr(0, rest.find(" and ")));
+  rest.remove_prefix(min(rest.find(" have "), rest.size()));
+  take_word(rest);
+  int points = 0;
+  if (seat < 0 || !drop_suffix(rest, " points") ||
+      !parse_number(take_word(rest), points) || points > UINT16_MAX) {
+    bad = true;
+    return;
+  }
+  record.points[seat % 2] = points;
+  if (++scores < 2) {
+    return;
+  }
+  in_hand = false;
+  if (bad || seen != SEEN_ALL || plays != 20 || tricks != 5) {
+    ++dropped;
+    return;
+  }
+  // the transcript does not show what the dealer threw away for the
+  // upcard, so the dealer's hand is left with the cards it played
+  const int dealer = record.dealer();
+  if (record.round() == 1) {
+    record.hands[dealer] &= ~(1u << record.upcard);
+  }
+  records.push_back(record);
+}
+
+namespace {
+
+// Splits are no larger than this, so the records waiting to be written
+// stay few however large the file is
+const uint64_t SPLIT_BYTES = 1 << 24;
+
+// The games of one byte range of a file
+struct Split {
+  vector<HandRecord> records;
+  uint32_t games = 0;
+  long dropped = 0;
+  bool done = false;
+};
+
+// The splits of a file, handed out to threads in file order
+struct SplitQueue {
+  const char *path;
+  uint64_t size;
+  size_t chunk_size;
+  vector<Split> parts;
+  size_t next = 0;      // the first split not handed out
+  size_t written = 0;   // the first split not written
+  size_t ahead = 0;     // splits that can be handed out past written
+  mutex lock;
+  condition_variable changed;
+};
+
+// EFFECTS: Parses the games of queue's file whose command lines start in
+//          bytes [begin, end), reading a chunk at a time, and stops at end
+//          if no game starts before it
+void parse_split(const SplitQueue &queue, uint64_t begin, uint64_t end,
+                 Split &split) {
+  const size_t chunk_size = queue.chunk_size;
+  ifstream in(queue.path, ios::binary);
+  // from the byte before begin, so a line that starts at begin is whole
+  uint64_t offset = begin > 0 ? begin - 1 : 0;
+  bool skipping = begin > 0;  // the partial line before the split
+  in.seekg(offset);
+  TranscriptParser parser;
+  bool started = false;
+  bool done = false;
+  string pending;
+  vector<char> buffer(chunk_size);
+  while (!done && in.read(buffer.data(), chunk_size).gcount() > 0) {
+    pending.append(buffer.data(), in.gcount());
+    size_t pos = 0;
+    for (size_t nl; !done && (nl = pending.find('\n', pos)) != string::npos;
+         pos = nl + 1) {
+      const string_view line(pending.data() + pos, nl - pos);
+      const bool past_end = offset + pos >= end;
+      if (starts_with(line, COMMAND) && !skipping) {
+        done = past_end;
+        started = true;
+      }
+      // no game starts in the range, so the game running through it is
+      // another split's to parse
+      done = done || (past_end && !started);
+      if (started && !done && !skipping) {
+        parser.parse_line(line, split.records);
+      }
+      skipping = false;
+    }
+    offset += pos;
+    pending.erase(0, pos);
+  }
+  // a last line with no line ending
+  if (started && !done && !pending.empty()) {
+    parser.parse_line(pending, split.records);
+  }
+  parser.finish();
+  split.games = parser.games();
+  split.dropped = parser.bad_hands();
+  split.done = true;
+}
+
+// EFFECTS: Parses splits from queue until none are left, waiting while
+//          the splits parsed but not written are as many as queue allows
+void parse_splits(SplitQueue &queue) {
+  const size_t count = queue.parts.size();
+  unique_lock<mutex> guard(queue.lock);
+  while (true) {
+    queue.changed.wait(guard, [&queue, count] {
+      return queue.next == count || queue.next < queue.written + queue.ahead;
+    });
+    if (queue.next == count) {
+      return;
+    }
+    const size_t i = queue.next++;
+    guard.unlock();
+    Split part;
+    parse_split(queue, queue.size * i / count, queue.size * (i + 1) / count, part);
+    guard.lock();
+    queue.parts[i] = move(part);
+    queue.changed.notify_all();
+  }
+}
+
+} // namespace
+
+long Transcript_convert(const char *path, int threads,
+                        const function<void(const vector<HandRecord> &)> &write,
+                        size_t chunk_size) {
+  ifstream in(path, ios::binary | ios::ate);
+  if (!in.is_open()) {
+    return -1;
+  }
+  if (threads <= 0) {
+    threads = max(1u, thread::hardware_concurrency());
+  }
+  SplitQueue queue;
+  queue.path = path;
+  queue.size = in.tellg();
+  queue.chunk_size = chunk_size;
+  queue.ahead = 2 * threads;
+  // enough splits to keep every thread busy, but none smaller than a chunk
+  const uint64_t wanted = max<uint64_t>(threads, queue.size / SPLIT_BYTES);
+  queue.parts.resize(max<uint64_t>(1, min(wanted, queue.size / chunk_size)));
+  vector<thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back(parse_splits, ref(queue));
+  }
+
+  // the calling thread writes each split once it and those before it are
+  // parsed, so the game numbers before it are known
+  long dropped = 0;
+  uint32_t first_game = 0;
+  for (size_t i = 0; i < queue.parts.size(); ++i) {
+    unique_lock<mutex> guard(queue.lock);
+    queue.changed.wait(guard, [&queue, i] { return queue.parts[i].done; });
+    Split part = move(queue.parts[i]);
+    ++queue.written;
+    guard.unlock();
+    queue.changed.notify_all();
+    for (HandRecord &record : part.records) {
+      record.game += first_game;
+    }
+    write(part.records);
+    first_game += part.games;
+    dropped += part.dropped;
+  }
+  for (thread &worker : workers) {
+    worker.join();
+  }
+  return dropped;
+}
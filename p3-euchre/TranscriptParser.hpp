@@ -0,0 +1,91 @@
+#ifndef TRANSCRIPTPARSER_HPP
+#define TRANSCRIPTPARSER_HPP
+/* TranscriptParser.hpp
+ *
+ * Turns game transcripts, in the exact text euchre.exe prints, back into
+ * HandRecords.  The parser is fed one line at a time and keeps only the
+ * state of the hand in progress, so transcripts of any length stream
+ * through it.  Transcript_convert reads a file in fixed-size blocks,
+ * splits it between threads at game boundaries, and hands the records of
+ * each split on in file order as soon as it is parsed, so only the splits
+ * in progress are held in memory.
+ *
+ * A transcript never shows the cards a player was dealt, only the cards
+ * they play, so each seat's dealt hand is rebuilt from its plays.  The one
+ * card it cannot show is the dealer's discard after picking up the
+ * upcard: in that case the dealer's hand in the record holds the four
+ * dealt cards that were played, without the upcard.
+ */
+
+
+#include "GameRecord.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class TranscriptParser {
+public:
+  //EFFECTS Initializes a parser that has seen no games; the first game
+  //  it sees is numbered 0
+  TranscriptParser();
+
+  //EFFECTS Parses one line of transcript, without its line ending.  When
+  //  the line finishes a hand, appends the hand's record to records.
+  //  Lines that are not part of the record, such as a human player's
+  //  prompts, are skipped.
+  void parse_line(std::string_view line, std::vector<HandRecord> &records);
+
+  //EFFECTS Ends the input.  A hand still in progress is dropped.
+  void finish();
+
+  //EFFECTS Returns the number of games started so far
+  std::uint32_t games() const { return game_count; }
+
+  //EFFECTS Returns the number of hands dropped because their lines did
+  //  not make sense, such as a play by a player not at the table
+  long bad_hands() const { return dropped; }
+
+private:
+  std::string names[4];  // by seat, from the game's command line
+  std::uint32_t game_count;
+  long dropped;
+  HandRecord record;     // the hand being read
+  bool in_hand;
+  bool bad;              // something in the hand did not parse
+  int passes;
+  int plays;
+  int tricks;
+  int scores;            // score lines read
+  int seen;              // SEEN_ bits for the parts of the hand read
+
+  // EFFECTS: Returns the seat of the player called name, or -1
+  int seat_of(std::string_view name) const;
+
+  void start_game(std::string_view line);
+  void start_hand(int number);
+  void parse_card_line(const Card &card, std::string_view rest);
+  void parse_score(std::string_view line, std::vector<HandRecord> &records);
+
+  // EFFECTS: Reads a line that names a player and returns true, or
+  //          returns false if the line is not one of those
+  bool parse_player_line(std::string_view line);
+};
+
+//REQUIRES threads >= 0, chunk_size > 0
+//EFFECTS Parses the transcripts in the file at path into records,
+//  numbered from game 0, and calls write with them in the order of the
+//  file, one byte range of the file at a time.  The file is read
+//  chunk_size bytes at a time, and its ranges are parsed by up to threads
+//  threads at once (0 means one per hardware thread), each from the first
+//  game that starts in its range; write is called on the calling thread.
+//  Returns the number of hands dropped, as by bad_hands, or -1 if the
+//  file cannot be read.
+long Transcript_convert(
+    const char *path, int threads,
+    const std::function<void(const std::vector<HandRecord> &)> &write,
+    std::size_t chunk_size = 1 << 16);
+
+#endif // TRANSCRIPTPARSER_HPP
@@ -0,0 +1,181 @@
+#include "TranscriptParser.hpp"
+#include "Game.hpp"
+#include "GameRecord.hpp"
+#include "Pack.hpp"
+#include "Player.hpp"
+#include "unit_test_framework.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const char *const NAMES[] = {"Adi", "Barbara", "Chi-Chih", "Dabbala"};
+
+// Plays an all-Simple game to points, writing its transcript after the
+// command line euchre.exe would echo, and returns the game's own records
+static vector<HandRecord> play_game(const Pack &pack, bool shuffle, uint64_t *seed,
+                                    ostream &out, int points = 10) {
+    vector<Player*> players;
+    out << "./euchre.exe pack.in " << (seed ? "random" : "shuffle") << " "
+        << points << " ";
+    for (const char *name : NAMES) {
+        players.push_back(Player_factory(name, "Simple"));
+        out << name << " Simple ";
+    }
+    out << "\n";
+    vector<HandRecord> records;
+    EuchreGame game(pack, shuffle, points, players, &out);
+    if (seed) {
+        game.use_random_shuffle(*seed);
+    }
+    game.set_record(&records, 0);
+    game.startGame();
+    for (Player *p : players) {
+        delete p;
+    }
+    return records;
+}
+
+// A record parsed from a transcript says everything the game's own record
+// does, except the dealer's discard
+static void assert_matches(const HandRecord &parsed, const HandRecord &played) {
+    ASSERT_EQUAL(parsed.hand, played.hand);
+    ASSERT_EQUAL(parsed.upcard, played.upcard);
+    ASSERT_EQUAL(parsed.bid, played.bid);
+    ASSERT_EQUAL(parsed.winners, played.winners);
+    ASSERT_EQUAL(parsed.points[0], played.points[0]);
+    ASSERT_EQUAL(parsed.points[1], played.points[1]);
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_EQUAL(parsed.plays[i], played.plays[i]);
+    }
+    for (int seat = 0; seat < 4; ++seat) {
+        if (seat != played.dealer() || played.round() == 2) {
+            ASSERT_EQUAL(parsed.hands[seat], played.hands[seat]);
+        }
+    }
+    const uint32_t dealt = played.hands[played.dealer()];
+    const uint32_t known = parsed.hands[played.dealer()];
+    ASSERT_EQUAL(known & ~dealt, 0u);
+    ASSERT_TRUE(CardSet::popcount(known) >= 4);
+}
+
+// Converts the file at path, appending its records to records
+static long convert(const char *path, int threads, vector<HandRecord> &records,
+                    size_t chunk_size = 1 << 16) {
+    return Transcript_convert(path, threads,
+        [&records](const vector<HandRecord> &part) {
+            records.insert(records.end(), part.begin(), part.end());
+        }, chunk_size);
+}
+
+// The reference transcript parses into the game's own records
+TEST(test_parse_reference_transcript) {
+    ifstream pack_in("pack.in");
+    Pack pack(pack_in);
+    ostringstream transcript;
+    vector<HandRecord> played = play_game(pack, true, nullptr, transcript);
+
+    vector<HandRecord> parsed;
+    ASSERT_EQUAL(convert("euchre_test01.out.correct", 1, parsed), 0);
+    ASSERT_EQUAL(parsed.size(), played.size());
+    for (size_t i = 0; i < parsed.size(); ++i) {
+        ASSERT_EQUAL(parsed[i].game, 0u);
+        assert_matches(parsed[i], played[i]);
+    }
+}
+
+// Human players' prompts are skipped
+TEST(test_parse_human_transcript) {
+    vector<HandRecord> parsed;
+    ASSERT_EQUAL(convert("euchre_test50.out.correct", 1, parsed), 0);
+    ASSERT_FALSE(parsed.empty());
+    ASSERT_EQUAL(parsed[0].dealer(), 0);
+}
+
+// Any split of a file of many games gives the same records, numbered by
+// game in file order
+TEST(test_parse_splits_agree) {
+    vector<vector<HandRecord>> played;
+    {
+        ofstream out("TranscriptParser_test.out");
+        for (uint64_t seed = 0; seed < 40; ++seed) {
+            played.push_back(play_game(Pack(), false, &seed, out));
+        }
+    }
+    const size_t chunks[] = {1 << 16, 4096, 100};
+    const int threads[] = {1, 3, 7};
+    for (int t = 0; t < 3; ++t) {
+        vector<HandRecord> parsed;
+        ASSERT_EQUAL(convert("TranscriptParser_test.out", threads[t],
+                             parsed, chunks[t]), 0);
+        size_t i = 0;
+        for (uint32_t game = 0; game < played.size(); ++game) {
+            for (const HandRecord &hand : played[game]) {
+                ASSERT_EQUAL(parsed[i].game, game);
+                assert_matches(parsed[i++], hand);
+            }
+        }
+        ASSERT_EQUAL(parsed.size(), i);
+    }
+    remove("TranscriptParser_test.out");
+}
+
+// Scores past what a byte holds parse as the game recorded them
+TEST(test_parse_long_game) {
+    uint64_t seed = 11;
+    vector<HandRecord> played;
+    {
+        ofstream out("TranscriptParser_long.out");
+        played = play_game(Pack(), false, &seed, out, 400);
+    }
+    ASSERT_TRUE(max(played.back().points[0], played.back().points[1]) >= 400);
+    vector<HandRecord> parsed;
+    ASSERT_EQUAL(convert("TranscriptParser_long.out", 2, parsed, 4096), 0);
+    ASSERT_EQUAL(parsed.size(), played.size());
+    for (size_t i = 0; i < parsed.size(); ++i) {
+        assert_matches(parsed[i], played[i]);
+    }
+
+    // split four ways, the one game is all the first split's; the others
+    // start inside it and have nothing to parse
+    vector<size_t> sizes;
+    ASSERT_EQUAL(Transcript_convert("TranscriptParser_long.out", 4,
+        [&sizes](const vector<HandRecord> &part) { sizes.push_back(part.size()); },
+        4096), 0);
+    ASSERT_EQUAL(sizes.size(), 4u);
+    ASSERT_EQUAL(sizes[0], played.size());
+    ASSERT_EQUAL(sizes[1] + sizes[2] + sizes[3], 0u);
+    remove("TranscriptParser_long.out");
+}
+
+// A hand that does not make sense is dropped, and the rest are kept
+TEST(test_parse_bad_hands) {
+    ifstream in("euchre_test01.out.correct");
+    TranscriptParser parser;
+    vector<HandRecord> records;
+    string line;
+    int hands = 0;
+    while (getline(in, line)) {
+        hands += line.rfind("Hand ", 0) == 0;
+        // someone not at the table plays in hand 1
+        if (hands == 2 && line.find(" played by ") != string::npos) {
+            line = "Ace of Spades played by Nobody";
+        }
+        parser.parse_line(line, records);
+    }
+    parser.parse_line("Hand 99", records);
+    parser.parse_line("Fran deals", records);
+    parser.finish();
+    ASSERT_EQUAL(parser.games(), 1u);
+    ASSERT_EQUAL(parser.bad_hands(), 2);
+    ASSERT_EQUAL(records.size(), size_t(hands - 1));
+    ASSERT_EQUAL(records[0].hand, 0);
+    ASSERT_EQUAL(records[1].hand, 2);
+}
+
+TEST_MAIN()
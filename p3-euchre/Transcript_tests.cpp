@@ -0,0 +1,68 @@
+#include "Transcript.hpp"
+#include "Card.hpp"
+#include "unit_test_framework.hpp"
+
+#include <sstream>
+#include <string>
+
+using namespace std;
+
+// Text is identical to what the stream operators produce
+TEST(test_transcript_matches_ostream) {
+    ostringstream expected;
+    ostringstream actual;
+    {
+        TranscriptWriter writer(&actual);
+        for (int id = 0; id < NUM_CARDS; ++id) {
+            Card c = Card_from_id(static_cast<CardId>(id));
+            expected << c << " led by " << c.get_suit() << " "
+                     << c.get_rank() << " " << id - 7 << "\n";
+            writer << c << " led by " << c.get_suit() << " "
+                   << c.get_rank() << " " << id - 7 << '\n';
+        }
+    }
+    ASSERT_EQUAL(actual.str(), expected.str());
+}
+
+// Nothing reaches the stream until a flush or the buffer fills
+TEST(test_transcript_buffers) {
+    ostringstream oss;
+    TranscriptWriter writer(&oss);
+    writer << "Hand " << 0 << '\n';
+    ASSERT_EQUAL(oss.str(), "");
+    writer.flush();
+    ASSERT_EQUAL(oss.str(), "Hand 0\n");
+    string line(100, 'x');
+    size_t lines = 2 * TranscriptWriter::BUFFER_SIZE / line.size();
+    for (size_t i = 0; i < lines; ++i) {
+        writer << line;
+    }
+    ASSERT_TRUE(oss.str().size() > 7);
+    writer.flush();
+    ASSERT_EQUAL(oss.str().size(), 7 + lines * line.size());
+}
+
+TEST(test_transcript_line_buffered) {
+    ostringstream oss;
+    TranscriptWriter writer(&oss);
+    writer.set_line_buffered(true);
+    writer << "Adi passes";
+    ASSERT_EQUAL(oss.str(), "");
+    writer << '\n';
+    ASSERT_EQUAL(oss.str(), "Adi passes\n");
+}
+
+TEST(test_transcript_disabled) {
+    TranscriptWriter writer(nullptr);
+    ASSERT_FALSE(writer.enabled());
+    writer << "ignored" << 3 << Card(ACE, SPADES);
+    writer.flush();
+}
+
+TEST(test_card_names) {
+    ASSERT_EQUAL(Card_name(Card(EIGHT, DIAMONDS)), "Eight of Diamonds");
+    ASSERT_EQUAL(Rank_name(QUEEN), "Queen");
+    ASSERT_EQUAL(Suit_name(CLUBS), "Clubs");
+}
+
+TEST_MAIN()
@@ -0,0 +1,61 @@
+#include "WorkerPool.hpp"
+#include <cassert>
+
+using namespace std;
+
+WorkerPool::WorkerPool(int threads) : thread_count(threads) {
+  assert(threads > 0);
+}
+
+WorkerPool::~WorkerPool() {
+  {
+    lock_guard<mutex> guard(lock);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (thread &t : helpers) {
+    t.join();
+  }
+}
+
+void WorkerPool::run(const function<void(int)> &job_in) {
+  if (thread_count == 1) {
+    job_in(0);
+    return;
+  }
+  if (helpers.empty()) {
+    // only this thread changes generation, so it is safe to read here
+    for (int t = 1; t < thread_count; ++t) {
+      helpers.emplace_back(&WorkerPool::helper, this, t, generation);
+    }
+  }
+  {
+    lock_guard<mutex> guard(lock);
+    job = &job_in;
+    pending = thread_count - 1;
+    ++generation;
+  }
+  wake.notify_all();
+  job_in(0);
+  unique_lock<mutex> guard(lock);
+  done.wait(guard, [this] { return pending == 0; });
+  job = nullptr;
+}
+
+void WorkerPool::helper(int index, uint64_t jobs_seen) {
+  unique_lock<mutex> guard(lock);
+  while (true) {
+    wake.wait(guard, [&] { return stopping || generation != jobs_seen; });
+    if (stopping) {
+      return;
+    }
+    jobs_seen = generation;
+    const function<void(int)> &current = *job;
+    guard.unlock();
+    current(index);
+    guard.lock();
+    if (--pending == 0) {
+      done.notify_one();
+    }
+  }
+}
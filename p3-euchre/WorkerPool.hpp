@@ -0,0 +1,57 @@
+#ifndef WORKERPOOL_HPP
+#define WORKERPOOL_HPP
+/* WorkerPool.hpp
+ *
+ * A fixed set of threads that run one job at a time, for work that is
+ * handed out many times a second, such as a search player's decisions.
+ * Starting and joining threads for every job costs tens of microseconds,
+ * a real share of a short search, so the pool's helper threads start with
+ * the first job and then sleep between jobs until the pool is destroyed.
+ */
+
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerPool {
+public:
+  //REQUIRES threads > 0
+  //EFFECTS Initializes a pool that runs each job on threads threads: the
+  //  calling thread and threads - 1 helpers
+  explicit WorkerPool(int threads);
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool & operator=(const WorkerPool &) = delete;
+
+  //EFFECTS Stops and joins the helpers
+  ~WorkerPool();
+
+  //EFFECTS Returns the number of threads a job runs on
+  int size() const { return thread_count; }
+
+  //EFFECTS Calls job(t) for every t from 0 to size() - 1, all at once,
+  //  job(0) on the calling thread, and returns when every call has
+  //  returned.  Only one thread may run jobs on a pool.
+  void run(const std::function<void(int)> &job);
+
+private:
+  int thread_count;
+  std::vector<std::thread> helpers;   // started by the first run
+  std::mutex lock;
+  std::condition_variable wake;       // a job is ready, or the pool stops
+  std::condition_variable done;       // the last helper finished the job
+  const std::function<void(int)> *job = nullptr;
+  std::uint64_t generation = 0;       // jobs handed out so far
+  int pending = 0;                    // helpers still in the current job
+  bool stopping = false;
+
+  // EFFECTS: Runs job(index) for every job after the first jobs_seen,
+  //          until the pool stops
+  void helper(int index, std::uint64_t jobs_seen);
+};
+
+#endif // WORKERPOOL_HPP
@@ -0,0 +1,59 @@
+#include "WorkerPool.hpp"
+#include "unit_test_framework.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Every job runs once on every thread, however many jobs there are
+TEST(test_worker_pool_runs_every_index) {
+    WorkerPool pool(4);
+    ASSERT_EQUAL(pool.size(), 4);
+    vector<int> calls(4, 0);
+    for (int job = 0; job < 200; ++job) {
+        pool.run([&calls](int t) { ++calls[t]; });
+    }
+    for (int t = 0; t < 4; ++t) {
+        ASSERT_EQUAL(calls[t], 200);
+    }
+}
+
+// Thread 0 is the caller, and the helpers are the same threads every job
+TEST(test_worker_pool_keeps_threads) {
+    WorkerPool pool(3);
+    vector<thread::id> first(3);
+    pool.run([&first](int t) { first[t] = this_thread::get_id(); });
+    ASSERT_TRUE(first[0] == this_thread::get_id());
+    ASSERT_TRUE(first[1] != first[0] && first[2] != first[0]);
+    for (int job = 0; job < 20; ++job) {
+        vector<thread::id> ids(3);
+        pool.run([&ids](int t) { ids[t] = this_thread::get_id(); });
+        ASSERT_TRUE(ids == first);
+    }
+}
+
+// run returns only once every thread has finished the job
+TEST(test_worker_pool_waits_for_job) {
+    WorkerPool pool(4);
+    atomic<int> finished(0);
+    pool.run([&finished](int t) {
+        this_thread::sleep_for(chrono::milliseconds(5 * t));
+        ++finished;
+    });
+    ASSERT_EQUAL(finished.load(), 4);
+}
+
+// A pool of one starts no threads
+TEST(test_worker_pool_single) {
+    WorkerPool pool(1);
+    thread::id id;
+    pool.run([&id](int t) {
+        ASSERT_EQUAL(t, 0);
+        id = this_thread::get_id();
+    });
+    ASSERT_TRUE(id == this_thread::get_id());
+}
+
+TEST_MAIN()
@@ -0,0 +1,252 @@
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Bench.hpp"
+#include "Card.hpp"
+#include "Game.hpp"
+#include "Pack.hpp"
+#include "Player.hpp"
+#include "SimpleBatch.hpp"
+
+using namespace std;
+
+void displayWarning() {
+    cout << "Usage: bench.exe [--reps N] [--warmup N] [--min-ms MS] "
+     << "[--filter TEXT] [--json FILE]" << endl;
+}
+
+
+// every card in the euchre pack, in Card_id order;
+vector<Card> euchre_cards() {
+    vector<Card> cards;
+    for (CardId id = 0; id < PackShuffle::SIZE; id++){
+        cards.push_back(Card_from_euchre_id(id));
+    }
+    return cards;
+}
+
+void bench_card_less(BenchSuite &suite) {
+    const vector<Card> cards = euchre_cards();
+    // every pair under every trump, as many times as it takes;
+    suite.run("Card_less(a, b, trump)", [&cards](long iterations) {
+        long ops = 0;
+        while (ops < iterations){
+            for (const Card &a : cards){
+                for (const Card &b : cards){
+                    Bench_keep(Card_less(a, b, Suit(ops & 3)));
+                }
+                ops += cards.size();
+            }
+        }
+        return ops;
+    });
+    suite.run("Card_less(a, b, led, trump)", [&cards](long iterations) {
+        long ops = 0;
+        while (ops < iterations){
+            for (const Card &a : cards){
+                const Card &led = cards[ops % cards.size()];
+                for (const Card &b : cards){
+                    Bench_keep(Card_less(a, b, led, Suit(ops & 3)));
+                }
+                ops += cards.size();
+            }
+        }
+        return ops;
+    });
+}
+
+void bench_pack(BenchSuite &suite) {
+    Pack pack;
+    Rng rng(280);
+    suite.run("Pack::shuffle()", [&pack](long iterations) {
+        for (long i = 0; i < iterations; i++){
+            pack.shuffle();
+            Bench_keep(pack);
+        }
+        return iterations;
+    });
+    suite.run("Pack::shuffle(Rng&)", [&pack, &rng](long iterations) {
+        for (long i = 0; i < iterations; i++){
+            pack.shuffle(rng);
+            Bench_keep(pack);
+        }
+        return iterations;
+    });
+    suite.run("Pack::deal_one", [&pack](long iterations) {
+        long ops = 0;
+        while (ops < iterations){
+            pack.reset();
+            while (!pack.empty()){
+                Bench_keep(pack.deal_one());
+                ops++;
+            }
+        }
+        return ops;
+    });
+}
+
+// Simple players with hands dealt from shuffled packs;
+struct SimpleHands {
+    static const int PLAYERS = 16;
+    unique_ptr<Player> players[PLAYERS];
+    Card upcards[PLAYERS];
+
+    SimpleHands() {
+        Pack pack;
+        Rng rng(280);
+        for (int i = 0; i < PLAYERS; i++){
+            players[i].reset(Player_factory("Bench", "Simple"));
+            pack.shuffle(rng);
+            for (int card = 0; card < 5; card++){
+                players[i]->add_card(pack.deal_one());
+            }
+            upcards[i] = pack.deal_one();
+        }
+    }
+};
+
+void bench_simple_bidding(BenchSuite &suite, const SimpleHands &hands) {
+    suite.run("SimplePlayer::make_trump", [&hands](long iterations) {
+        long ops = 0;
+        while (ops < iterations){
+            for (int i = 0; i < SimpleHands::PLAYERS; i++){
+                Suit order_up = SPADES;
+                const int round = 1 + (ops & 1);
+                Bench_keep(hands.players[i]->make_trump(hands.upcards[i],
+                                                        i % 4 == 0, round, order_up));
+                ops++;
+            }
+        }
+        return ops;
+    });
+}
+
+// The lead and play benchmarks give each player its hand back before
+// playing it out, so their times include five add_card calls a hand;
+void bench_simple_play(BenchSuite &suite) {
+    const vector<Card> cards = euchre_cards();
+    unique_ptr<Player> player(Player_factory("Bench", "Simple"));
+    suite.run("SimplePlayer::lead_card", [&cards, &player](long iterations) {
+        long ops = 0;
+        for (size_t deal = 0; ops < iterations; deal = (deal + 5) % 20){
+            for (int card = 0; card < 5; card++){
+                player->add_card(cards[deal + card]);
+            }
+            for (int card = 0; card < 5; card++, ops++){
+                Bench_keep(player->lead_card(Suit(ops & 3)));
+            }
+        }
+        return ops;
+    });
+    suite.run("SimplePlayer::play_card", [&cards, &player](long iterations) {
+        long ops = 0;
+        for (size_t deal = 0; ops < iterations; deal = (deal + 5) % 20){
+            for (int card = 0; card < 5; card++){
+                player->add_card(cards[deal + card]);
+            }
+            for (int card = 0; card < 5; card++, ops++){
+                const Card &led = cards[(deal + 7 * card) % cards.size()];
+                Bench_keep(player->play_card(led, Suit(ops & 3)));
+            }
+        }
+        return ops;
+    });
+}
+
+void bench_game(BenchSuite &suite) {
+    vector<Player*> players;
+    for (int seat = 0; seat < 4; seat++){
+        players.push_back(Player_factory("Bench", "Simple"));
+    }
+    uint64_t gameNumber = 0;
+    // one operation is one hand, dealing, bidding and five tricks;
+    suite.run("EuchreGame hand", [&players, &gameNumber](long iterations) {
+        long hands = 0;
+        while (hands < iterations){
+            EuchreGame game(Pack(), false, 10, players, nullptr);
+            game.use_random_shuffle(Rng::game_seed(280, gameNumber++));
+            hands += game.startGame().hands_played;
+        }
+        return hands;
+    });
+    for (Player *player : players){
+        delete player;
+    }
+}
+
+void bench_batch(BenchSuite &suite) {
+    SimpleGameBatch16 batch(Pack(), false, 10);
+    const long GAMES = 64;
+    vector<uint64_t> seeds(GAMES);
+    vector<GameResult> results(GAMES);
+    uint64_t gameNumber = 0;
+    // one operation is one hand of one lane's game;
+    suite.run("SimpleGameBatch16 hand", [&](long iterations) {
+        long hands = 0;
+        while (hands < iterations){
+            for (uint64_t &seed : seeds){
+                seed = Rng::game_seed(280, gameNumber++);
+            }
+            batch.play(GAMES, seeds.data(), results.data());
+            for (const GameResult &result : results){
+                hands += result.hands_played;
+            }
+        }
+        return hands;
+    });
+}
+
+
+int main(int argc, char **argv) {
+  BenchOptions options;
+  const char *jsonFile = nullptr;
+  for (int i = 1; i < argc; i++){
+    if (i + 1 >= argc){
+        displayWarning();
+        return 1;
+    }
+    if (strcmp(argv[i], "--reps") == 0){
+        options.reps = max(1, atoi(argv[++i]));
+    }
+    else if (strcmp(argv[i], "--warmup") == 0){
+        options.warmup = max(0, atoi(argv[++i]));
+    }
+    else if (strcmp(argv[i], "--min-ms") == 0){
+        options.min_rep_ns = atof(argv[++i]) * 1e6;
+    }
+    else if (strcmp(argv[i], "--filter") == 0){
+        options.filter = argv[++i];
+    }
+    else if (strcmp(argv[i], "--json") == 0){
+        jsonFile = argv[++i];
+    }
+    else{
+        displayWarning();
+        return 1;
+    }
+  }
+
+  BenchSuite suite(options);
+  bench_card_less(suite);
+  bench_pack(suite);
+  SimpleHands hands;
+  bench_simple_bidding(suite, hands);
+  bench_simple_play(suite);
+  bench_game(suite);
+  bench_batch(suite);
+  suite.print_table(cout);
+
+  if (jsonFile){
+    ofstream jsonOut(jsonFile);
+    if (!jsonOut.is_open()){
+      cout << "Error opening " << jsonFile << endl;
+      return 1;
+    }
+    suite.print_json(jsonOut);
+  }
+  return 0;
+}
@@ -3,295 +3,82 @@
 #include <fstream>
 #include <iostream>
 #include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
 #include "Pack.hpp"
 #include "Player.hpp"
 #include "Card.hpp"
+#include "Game.hpp"
+#include "Instrument.hpp"
+#include "Replay.hpp"
 
 using namespace std;
 
-class EuchreGame {
- public:
-  EuchreGame(Pack gamePack, bool shuffleCards, int winPoints,
-    vector<Player*> &playersInGame):
-    shuffle(shuffleCards), pointsNeededToWin(winPoints){
-        players = playersInGame;
-
-        pack = gamePack;
-        team1Points = 0;
-        team2Points = 0;
-    };
-
-  void startGame() {
-    while (team1Points < pointsNeededToWin && team2Points < pointsNeededToWin){
-        // which hand(s);
-        cout << "Hand " << currentHand << endl;
-        currentHand++;
+void displayWarning() {
+    cout << "Usage: euchre.exe PACK_FILENAME [shuffle|noshuffle|random] "
+     << "POINTS_TO_WIN NAME1 TYPE1 NAME2 TYPE2 NAME3 TYPE3 "
+     << "NAME4 TYPE4 [--quiet] [--seed SEED] [--record FILE] "
+     << "[--resume RECORD_FILE GAME HAND]" << endl;
+}
 
-        Suit currentTrump = SPADES;
-        shufflePack();
-        dealCards(players, trumpCard);
-        // who is the dealer;
-        cout << players[dealerIndex % 4]->get_name() << " deals" << endl;
-        // upcard;
-        cout << trumpCard << " turned up" << endl;
 
-        playHand(currentTrump, dealerIndex);
-        dealerIndex++;
-    }
-    if (team1Points >= pointsNeededToWin){
-        cout << players[0]->get_name() << " and " <<
-        players[2]->get_name() << " win!" << endl;
-        return;
-    }
-    else {
-        cout << players[1]->get_name() << " and " <<
-        players[3]->get_name() << " win!" << endl;
-        return;
+// Restores game to the state before a hand of a recorded game; args are
+// the record file, the game number and the hand number.  Returns false if
+// the file does not hold the hands before it.
+bool resume(EuchreGame &game, const ReplaySetup &setup, char **args) {
+  GameRecordReader reader(args[0]);
+  const uint32_t gameNumber = strtoul(args[1], nullptr, 10);
+  const int hand = atoi(args[2]);
+  vector<HandRecord> records;
+  for (const HandRecord &record : reader){
+    if (record.game == gameNumber && record.hand == records.size()){
+      records.push_back(record);
     }
   }
-
- private:
-  std::vector<Player*> players;
-  Card trumpCard; // to make trump
-  Pack pack;
-  bool shuffle = false; 
-  int pointsNeededToWin; 
-  int dealerIndex = 0; 
-  int team1Points; int team2Points; 
-  int currentHand = 0;
-  
-  
-  void shufflePack(){
-    if (shuffle == true){
-        pack.shuffle();
-    }
-    else{
-        pack.reset();
-    }
-  }
-  
-  void dealTwoCards(int playerIndex){
-    players[playerIndex]->add_card(pack.deal_one());
-    players[playerIndex]->add_card(pack.deal_one());
-    return;
-  }
-
-  void dealThreeCards(int playerIndex){
-    players[playerIndex]->add_card(pack.deal_one());
-    players[playerIndex]->add_card(pack.deal_one());
-    players[playerIndex]->add_card(pack.deal_one());
-    return;
+  if (hand < 0 || records.size() < size_t(hand)){
+    cout << "Error: " << args[0] << " does not hold hands 0 to " << hand - 1
+    << " of game " << gameNumber << endl;
+    return false;
   }
+  game.restore(Replay_checkpoint(setup, records.data(), hand));
+  return true;
+}
 
-  void dealCards(vector<Player*> players, Card &firstCard){
-    
-    // first round;
-    for (int i = 1; i <= 4; i++){
-        if(i % 2 == 1){
-            dealThreeCards((dealerIndex + i) % 4);
-        }
-        else if (i % 2 == 0){
-            dealTwoCards((dealerIndex + i) % 4);
-        }
-    }
-
-    // second round;
-    for (int i = 1; i <= 4; i++){
-        if (i % 2 == 1){
-            dealTwoCards((dealerIndex + i) % 4);
-        }
-        else if (i % 2 == 0){
-            dealThreeCards((dealerIndex + i) % 4);
-        }
-    }
-
-    // trumpCard;
-    firstCard = pack.deal_one();
-  };
-
-  
-   int selectTrump(int dealerIdx, const Card trumpCard, Suit &trumpSuit){
-    
-    // round 1;
-    int round = 1;
-    for(int i = 1; i <= 4; i++){
-        int currentPlayer = (dealerIdx + i) % 4;
-        if (players[currentPlayer]->make_trump(trumpCard, 
-            dealerIdx % 4 == currentPlayer, round, trumpSuit)){ 
-                cout << players[currentPlayer]->get_name() << " orders up " << trumpSuit 
-                << endl;
-                players[dealerIdx % 4]->add_and_discard(trumpCard);
-                return currentPlayer;
-        }
-        else{
-            cout << players[currentPlayer]->get_name() << 
-                " passes" << endl;
-        }
-    }
-
-    // round 2;
-    round = 2;
-    for (int i = 1; i <= 4; i++){
-        int currentPlayer = (dealerIdx + i) % 4;
-        if (players[currentPlayer]->make_trump(trumpCard,
-            dealerIdx % 4 == currentPlayer, round, trumpSuit)){
-                cout << players[currentPlayer]->get_name() << " orders up " << trumpSuit 
-                    << "\n\n";
-                return currentPlayer;
-        }
-        else{
-            cout << players[currentPlayer]->get_name() <<
-                " passes" << endl;
-        }
-    }
-    return dealerIdx % 4;
-  };
-
-void displayScoreMessage(int team1Score, int team2Score, int trumpTeam){
-    if (team1Score > team2Score){
-        if (trumpTeam == 2){
-            team1Points += 2;
-            cout << players[0]->get_name() << " and " << players[2]->get_name() <<
-                " win the hand" << endl;
-            cout << "euchred!" << endl;
-            cout << players[0]->get_name() << " and " << players[2]->get_name() <<
-                " have " << team1Points << " points" << endl;
-            cout << players[1]->get_name() << " and " << players[3]->get_name() <<
-                " have " << team2Points << " points" << endl << endl;
-        }
-        else if(trumpTeam == 1){
-            team1Points += 1;
-            cout << players[0]->get_name() << " and " << players[2]->get_name() <<
-                " win the hand" << endl;
-            if (team1Score == 5) {
-                cout << "march!" << endl;
-                team1Points++;
-            }
-            cout << players[0]->get_name() << " and " << players[2]->get_name() <<
-                " have " << team1Points << " points" << endl;
-            cout << players[1]->get_name() << " and " << players[3]->get_name() <<
-                " have " << team2Points << " points" << endl << endl;
-            
-        }
-    }
-    else if (team2Score > team1Score){
-        if (trumpTeam == 1){
-            team2Points += 2;
-            cout << players[1]->get_name() << " and " << players[3]->get_name() <<
-                " win the hand" << endl;
-            cout << "euchred!" << endl;
-            cout << players[0]->get_name() << " and " << players[2]->get_name() <<
-                " have " << team1Points << " points" << endl;
-            cout << players[1]->get_name() << " and " << players[3]->get_name() <<
-                " have " << team2Points << " points" << endl << endl;
-        }
-        else if (trumpTeam == 2){
-            team2Points++;
-            cout << players[1]->get_name() << " and " << players[3]->get_name() <<
-                " win the hand" << endl;
-            if (team2Score == 5){
-                cout << "march!" << endl;
-                team2Points++;
-            }
-            cout << players[0]->get_name() << " and " << players[2]->get_name() <<
-                " have " << team1Points << " points" << endl;
-            cout << players[1]->get_name() << " and " << players[3]->get_name() <<
-                " have " << team2Points << " points" << endl << endl;
-        }
-    }
-    }
-
-  int determineTrickWinner(const Suit trumpSuit, int dealerIdx){
-     
-    // play a trick
-
-    // first player leads a card;
-    Card card1 = players[dealerIdx % 4]->lead_card(trumpSuit);
-    cout << card1 << " led by " << players[dealerIdx % 4]->get_name() << endl;
-    // second player leads a card;
-    Card card2 = players[(dealerIdx + 1) % 4]->play_card(card1, trumpSuit);
-    cout << card2 << " played by " << players[(dealerIdx + 1) % 4]->get_name() << endl;
-    // third player leads a card;
-    Card card3 = players[(dealerIdx + 2) % 4]->play_card(card1, trumpSuit);
-    cout << card3 << " played by " << players[(dealerIdx + 2) % 4]->get_name() << endl;
-    // forth player leads a card;
-    Card card4 = players[(dealerIdx + 3) % 4]->play_card(card1, trumpSuit);
-    cout << card4 << " played by " << players[(dealerIdx + 3) % 4]->get_name() << endl;
-
-    // find the winning card
-    Card winningCard = card1;
 
-    if (Card_less(winningCard, card2, card1, trumpSuit)){
-        winningCard = card2;
-    }
-    if (Card_less(winningCard, card3, card1, trumpSuit)){
-        winningCard = card3;
-    }
-    if (Card_less(winningCard, card4, card1, trumpSuit)){
-        winningCard = card4;
-    }
-
-    // find the card owner;
-    if (winningCard == card1) return dealerIdx % 4;
-    else if (winningCard == card2) return (dealerIdx + 1) % 4;
-    else if (winningCard == card3) return (dealerIdx + 2) % 4;
-    else if (winningCard == card4) return (dealerIdx + 3) % 4;
-    return -1;
-  };
+int main(int argc, char **argv) {
+  if (argc < 12){
+    displayWarning();
+    return 1;
+  }
 
-  void playHand(Suit trumpSuit, int dealerIdx){
-    int winningPlayer;
-    int team1Score = 0;
-    int team2Score = 0;
-    int trumpTeam = 0;
-    // make trump;
-    int trumpMaker = selectTrump(dealerIdx, trumpCard, trumpSuit);
-    // which is trump maker's team;
-    if (trumpMaker == 0 || trumpMaker == 2){
-        trumpTeam = 1;
+  // optional flags after the players;
+  bool quiet = false;
+  bool haveSeed = false;
+  uint64_t seed = 0;
+  const char *recordFile = nullptr;
+  char **resumeArgs = nullptr;
+  for (int i = 12; i < argc; i++){
+    if (strcmp(argv[i], "--quiet") == 0){
+        quiet = true;
     }
-    else if (trumpMaker == 1 || trumpMaker == 3){
-        trumpTeam = 2;
+    else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc){
+        haveSeed = true;
+        seed = strtoull(argv[++i], nullptr, 10);
     }
-    // for first round; first left player of dealer leads;
-    winningPlayer = determineTrickWinner(trumpSuit, (dealerIdx + 1) % 4);
-    //cout << winningPlayer << endl;
-    cout << players[winningPlayer]->get_name() << " takes the trick" << 
-        endl << endl;
-    if (winningPlayer == 0 || winningPlayer == 2){
-        team1Score++;
+    else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc){
+        recordFile = argv[++i];
     }
-    else if(winningPlayer == 1 || winningPlayer == 3){
-        team2Score++;
+    else if (strcmp(argv[i], "--resume") == 0 && i + 3 < argc){
+        resumeArgs = argv + i + 1;
+        i += 3;
     }
-    // for the next 4 rounds;
-    for(int i = 1; i < 5; i++){
-        winningPlayer = determineTrickWinner(trumpSuit, winningPlayer);
-        cout << players[winningPlayer]->get_name() << " takes the trick" << 
-            endl << endl;
-        if (winningPlayer == 0 || winningPlayer == 2){
-            team1Score++;
-        }
-        else if(winningPlayer == 1 || winningPlayer == 3){
-            team2Score++;
-        }
+    else{
+        displayWarning();
+        return 1;
     }
-    // find hand winners;
-
-    displayScoreMessage(team1Score, team2Score, trumpTeam);
   }
-};
-
- 
-
-void displayWarning() {
-    cout << "Usage: euchre.exe PACK_FILENAME [shuffle|noshuffle] "
-     << "POINTS_TO_WIN NAME1 TYPE1 NAME2 TYPE2 NAME3 TYPE3 "
-     << "NAME4 TYPE4" << endl;
-}
 
-
-int main(int argc, char **argv) {
   string inputFile = argv[1];
   ifstream inFile(argv[1]);
   if (!inFile.is_open()){
@@ -302,13 +89,27 @@ int main(int argc, char **argv) {
 
   // read win points;
   int winPoints = atoi(argv[3]);
+  if (recordFile && winPoints > MAX_RECORDED_POINTS){
+    cout << "Error: games to more than " << MAX_RECORDED_POINTS <<
+    " points cannot be recorded" << endl;
+    return 1;
+  }
 
-  // check shuffle or not;
+  // check shuffle or not; random shuffles are replayable from the seed;
   string shuffleOption = argv[2];
     bool shuffleCards;
+    bool randomShuffle = false;
     if(shuffleOption == "shuffle"){
         shuffleCards = true;
     }
+    else if (shuffleOption == "random"){
+        shuffleCards = true;
+        randomShuffle = true;
+        if (!haveSeed){
+            random_device device;
+            seed = (uint64_t(device()) << 32) | device();
+        }
+    }
     else{
         shuffleCards = false;
     }
@@ -321,19 +122,76 @@ int main(int argc, char **argv) {
     playersInGame.push_back(Player_factory(argv[10], argv[11]));
 
     // give command;
-    cout << "./euchre.exe " << inputFile << " " <<
-    argv[2] << " " << winPoints << " " << 
-    playersInGame[0]->get_name() << " " << argv[5] << " " << 
-    playersInGame[1]->get_name() << " " << argv[7] << " " << 
-    playersInGame[2]->get_name() << " " << argv[9] << " " << 
-    playersInGame[3]->get_name() << " " << argv[11] << " " << endl;
+    if (!quiet){
+        cout << "./euchre.exe " << inputFile << " " <<
+        argv[2] << " " << winPoints << " " <<
+        playersInGame[0]->get_name() << " " << argv[5] << " " <<
+        playersInGame[1]->get_name() << " " << argv[7] << " " <<
+        playersInGame[2]->get_name() << " " << argv[9] << " " <<
+        playersInGame[3]->get_name() << " " << argv[11] << " ";
+        if (randomShuffle){
+            cout << "--seed " << seed << " ";
+        }
+        cout << endl;
+    }
 
-    // set up game;
+    // set up game; a quiet game is headless;
     EuchreGame *game = new EuchreGame(gamePack, shuffleCards, winPoints,
-                        playersInGame); 
-    
-    // play the game;    
-    game->startGame();
+                        playersInGame, quiet ? nullptr : &cout);
+    if (randomShuffle){
+        game->use_random_shuffle(seed);
+    }
+    // human players prompt on cout too, so keep the transcript in step;
+    for (int i = 5; i <= 11; i += 2){
+        if (strcmp(argv[i], "Human") == 0){
+            game->set_line_buffered(true);
+        }
+    }
+
+    // jump to a hand of a recorded game, which must have been played
+    // with the same pack and shuffling;
+    if (resumeArgs && !resume(*game,
+        {gamePack, shuffleCards, randomShuffle, seed}, resumeArgs)){
+        for (Player *player : playersInGame){
+            delete player;
+        }
+        delete game;
+        return 1;
+    }
+
+    // keep a binary record of every hand if asked;
+    vector<HandRecord> records;
+    if (recordFile){
+        game->set_record(&records, 0);
+    }
+
+    // play the game;
+    GameResult result = game->startGame();
+
+    if (recordFile){
+        ofstream recordOut(recordFile, ios::binary);
+        GameRecordWriter writer(recordOut);
+        writer.write(records);
+        if (!writer.good()){
+            cout << "Error writing " << recordFile << endl;
+        }
+    }
+
+    // quiet mode prints only a one line summary;
+    if (quiet){
+        cout << playersInGame[0]->get_name() << " and " <<
+        playersInGame[2]->get_name() << " " << result.points[0] << ", " <<
+        playersInGame[1]->get_name() << " and " <<
+        playersInGame[3]->get_name() << " " << result.points[1] << ", " <<
+        result.hands_played << " hands, marches " << result.marches[0] <<
+        "-" << result.marches[1] << ", euchres " << result.euchres[0] <<
+        "-" << result.euchres[1] << endl;
+    }
+
+#ifdef EUCHRE_INSTRUMENT
+    // where the time went, for euchre_instrumented.exe;
+    Instrument_print(cerr, Instrument_summary());
+#endif
 
     // delete dynamics;
     for (int i = 0; i < 4; i++) {
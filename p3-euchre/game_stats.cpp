@@ -0,0 +1,54 @@
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include "GameRecord.hpp"
+#include "GameStats.hpp"
+
+using namespace std;
+
+void displayWarning() {
+    cout << "Usage: game_stats.exe RECORD_FILENAME [--csv CSV_FILE] "
+     << "[--threads N]" << endl;
+}
+
+
+int main(int argc, char **argv) {
+  if (argc < 2){
+    displayWarning();
+    return 1;
+  }
+  const char *csvFile = nullptr;
+  int threads = 0;
+  // optional flags;
+  for (int i = 2; i < argc; i++){
+    if (strcmp(argv[i], "--csv") == 0 && i + 1 < argc){
+        csvFile = argv[++i];
+    }
+    else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc){
+        threads = atoi(argv[++i]);
+    }
+    else{
+        displayWarning();
+        return 1;
+    }
+  }
+
+  GameRecordReader reader(argv[1]);
+  if (!reader.is_open()){
+    cout << "Error opening " << argv[1] << endl;
+    return 1;
+  }
+  GameStats stats = GameStats_of(reader.begin(), reader.size(), threads);
+  stats.print(cout);
+
+  if (csvFile){
+    ofstream csvOut(csvFile);
+    if (!csvOut.is_open()){
+      cout << "Error opening " << csvFile << endl;
+      return 1;
+    }
+    stats.print_csv(csvOut);
+  }
+  return 0;
+}
@@ -0,0 +1,19 @@
+#include <iostream>
+#include "HandTable.hpp"
+
+using namespace std;
+
+// Writes the hand-strength table that HandTable(path) maps
+int main(int argc, char **argv) {
+  if (argc > 2) {
+    cout << "Usage: hand_table.exe [OUTPUT_FILENAME]" << endl;
+    return 1;
+  }
+  const char *path = argc == 2 ? argv[1] : "hand_table.bin";
+  HandTable table;
+  if (!table.save(path)) {
+    cout << "Error writing " << path << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,117 @@
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include "Instrument.hpp"
+#include "Pack.hpp"
+#include "Tournament.hpp"
+
+using namespace std;
+
+void displayWarning() {
+    cout << "Usage: tournament.exe PACK_FILENAME [shuffle|noshuffle|random] "
+     << "POINTS_TO_WIN NUM_GAMES TYPE1 TYPE2 TYPE3 TYPE4 "
+     << "[--threads N] [--seed SEED] [--record FILE] [--stats CSV_FILE]" << endl;
+}
+
+
+int main(int argc, char **argv) {
+  if (argc < 9){
+    displayWarning();
+    return 1;
+  }
+
+  ifstream inFile(argv[1]);
+  if (!inFile.is_open()){
+    cout << "Error opening " << argv[1] << endl;
+    return 1;
+  }
+
+  TournamentConfig config;
+  config.pack = Pack(inFile);
+  config.shuffle = (string(argv[2]) == "shuffle");
+  config.random_shuffle = (string(argv[2]) == "random");
+  config.points_to_win = atoi(argv[3]);
+  config.games = atol(argv[4]);
+  for (int seat = 0; seat < 4; seat++){
+    config.strategies[seat] = argv[5 + seat];
+  }
+  const char *recordFile = nullptr;
+  const char *statsFile = nullptr;
+  // optional flags;
+  for (int i = 9; i < argc; i++){
+    if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc){
+        config.threads = atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc){
+        config.seed = strtoull(argv[++i], nullptr, 10);
+    }
+    else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc){
+        recordFile = argv[++i];
+    }
+    else if (strcmp(argv[i], "--stats") == 0 && i + 1 < argc){
+        statsFile = argv[++i];
+    }
+    else{
+        displayWarning();
+        return 1;
+    }
+  }
+
+  // every hand played goes to the record file too;
+  ofstream recordOut;
+  unique_ptr<GameRecordWriter> record;
+  if ((recordFile || statsFile) && config.points_to_win > MAX_RECORDED_POINTS){
+    cout << "Error: games to more than " << MAX_RECORDED_POINTS <<
+    " points cannot be recorded" << endl;
+    return 1;
+  }
+  if (recordFile){
+    recordOut.open(recordFile, ios::binary);
+    if (!recordOut.is_open()){
+      cout << "Error opening " << recordFile << endl;
+      return 1;
+    }
+    record.reset(new GameRecordWriter(recordOut));
+    config.record = record.get();
+  }
+
+  // statistics of every hand go to a CSV file and after the summary;
+  ofstream statsOut;
+  GameStats stats;
+  if (statsFile){
+    statsOut.open(statsFile);
+    if (!statsOut.is_open()){
+      cout << "Error opening " << statsFile << endl;
+      return 1;
+    }
+    config.stats = &stats;
+  }
+
+  TournamentResult result = run_tournament(config);
+  if (record && !record->good()){
+    cout << "Error writing " << recordFile << endl;
+    return 1;
+  }
+
+  // per-team summary;
+  for (int team = 0; team < 2; team++){
+    cout << config.strategies[team] << " and " << config.strategies[team + 2]
+    << " (team " << team + 1 << ") win " << result.wins[team] << " of "
+    << result.games << " games (" << 100.0 * result.win_rate(team)
+    << "%), " << result.marches[team] << " marches, "
+    << result.euchres[team] << " euchres" << endl;
+  }
+  cout << result.hands_played << " hands played" << endl;
+  if (statsFile){
+    stats.print(cout);
+    stats.print_csv(statsOut);
+  }
+#ifdef EUCHRE_INSTRUMENT
+  // where the time went, for tournament_instrumented.exe;
+  Instrument_print(cerr, Instrument_summary());
+#endif
+  return 0;
+}
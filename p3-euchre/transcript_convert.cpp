@@ -0,0 +1,57 @@
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "GameRecord.hpp"
+#include "TranscriptParser.hpp"
+
+using namespace std;
+
+void displayWarning() {
+    cout << "Usage: transcript_convert.exe TRANSCRIPT_FILENAME RECORD_FILENAME "
+     << "[--threads N]" << endl;
+}
+
+
+int main(int argc, char **argv) {
+  if (argc != 3 && argc != 5){
+    displayWarning();
+    return 1;
+  }
+  int threads = 0;
+  if (argc == 5){
+    if (strcmp(argv[3], "--threads") != 0){
+      displayWarning();
+      return 1;
+    }
+    threads = atoi(argv[4]);
+  }
+
+  ifstream in(argv[1]);
+  if (!in.is_open()){
+    cout << "Error opening " << argv[1] << endl;
+    return 1;
+  }
+  in.close();
+
+  // the records go out as each part of the transcript is parsed;
+  ofstream out(argv[2], ios::binary);
+  GameRecordWriter writer(out);
+  size_t hands = 0;
+  long dropped = Transcript_convert(argv[1], threads,
+    [&writer, &hands](const vector<HandRecord> &records){
+      writer.write(records);
+      hands += records.size();
+    });
+  if (dropped < 0){
+    cout << "Error opening " << argv[1] << endl;
+    return 1;
+  }
+  if (!writer.good()){
+    cout << "Error writing " << argv[2] << endl;
+    return 1;
+  }
+  cout << hands << " hands written, " << dropped << " dropped" << endl;
+  return 0;
+}
@@ -38,6 +38,8 @@
 
 #include <map>
 #include <utility>
+#include <chrono>
+#include <fstream>
 #include <string>
 #include <iostream>
 #include <sstream>
@@ -55,6 +57,16 @@
 #  include <regex>
 #endif
 
+// Running tests in parallel (-j) forks worker processes
+#if defined(__unix__) || defined(__APPLE__)
+#  define UNIT_TEST_CAN_FORK 1
+#  include <cstdio>
+#  include <sys/wait.h>
+#  include <unistd.h>
+#else
+#  define UNIT_TEST_CAN_FORK 0
+#endif
+
 // For compatibility with Visual Studio
 #include <iso646.h> // ciso646 removed in C++20
 
@@ -76,6 +88,16 @@
     register_##name((#name), name);                     \
   static void name()
 
+// A benchmark is a test whose body is one iteration of the code to time.
+// The body runs once as a plain test, then repeatedly to measure its
+// time per iteration, which is reported with the results and can be
+// checked against a baseline recorded earlier (see --help).
+#define BENCHMARK(name)                                 \
+  static void name();                                   \
+  static unit_test_framework::TestRegisterer            \
+    register_##name((#name), name, true);               \
+  static void name()
+
 #define TEST_MAIN()                                                     \
   int main(int argc, char** argv) {                                     \
     return                                                              \
@@ -118,6 +140,14 @@
     #precision ")"                                      \
   );
 
+// Evaluates expr repeatedly and fails if one evaluation takes longer on
+// average than budget, a std::chrono duration.
+#define ASSERT_FASTER_THAN(expr, budget)                \
+  unit_test_framework::Assertions::assert_faster_than(  \
+    [&]() { return (expr); }, (budget), __LINE__,       \
+    "ASSERT_FASTER_THAN(" #expr ", " #budget ")"        \
+  );
+
 // -----------------------------------------------------------------------------
 
 namespace unit_test_framework {
@@ -287,20 +317,91 @@ namespace unit_test_framework {
 
   // ---------------------------------------------------------------------------
 
+  struct TimingOptions {
+    bool report_time = false;      // print each test's wall time
+    double bench_ms = 20;          // time spent measuring each benchmark
+    double tolerance = 0.25;       // slowdown over the baseline allowed
+    std::map<std::string, double> baseline{};  // ns per iteration, by name
+    std::string save_path{};       // where to save this run as a baseline
+  };
+
+  class Timer {
+  public:
+    static double now_ns() {
+      return std::chrono::duration<double, std::nano>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // Calls func until the calls take at least min_ms, doubling the
+    // number of calls in a batch, and returns the fastest time per call
+    // of a few batches of that size.
+    template <class Func>
+    static double ns_per_call(Func&& func, double min_ms) {
+      const double batch_ns = min_ms * 1e6 / batches;
+      long calls = 1;
+      double elapsed = time_calls(func, calls);
+      while (elapsed < batch_ns and calls < (1L << 40)) {
+        calls *= 2;
+        elapsed = time_calls(func, calls);
+      }
+      double best = elapsed / calls;
+      for (int i = 1; i < batches; ++i) {
+        best = std::min(best, time_calls(func, calls) / calls);
+      }
+      return best;
+    }
+
+  private:
+    static const int batches = 5;
+
+    template <class Func>
+    static double time_calls(Func& func, long calls) {
+      const double start = now_ns();
+      for (long i = 0; i < calls; ++i) {
+        call(func, std::is_void<decltype(func())>{});
+      }
+      return now_ns() - start;
+    }
+
+    template <class Func>
+    static void call(Func& func, std::true_type) {
+      func();
+    }
+
+    // Keeps the compiler from dropping a call whose result is unused.
+    template <class Func>
+    static void call(Func& func, std::false_type) {
+      auto result = func();
+#if defined(__GNUC__) || defined(__clang__)
+      __asm__ __volatile__("" : : "g"(&result) : "memory");
+#else
+      static_cast<void>(result);
+#endif
+    }
+  };
+
+  // ---------------------------------------------------------------------------
+
   struct TestCase {
-    TestCase(const std::string& name_, Test_func_t test_func_)
-      : name(name_), test_func(test_func_) {}
+    TestCase(const std::string& name_, Test_func_t test_func_,
+             bool benchmark_ = false)
+      : name(name_), test_func(test_func_), benchmark(benchmark_) {}
 
-    void run(bool quiet_mode) {
+    void run(bool quiet_mode, const TimingOptions& timing) {
+      const double start = Timer::now_ns();
       try {
         if (not quiet_mode) {
           std::cout << "Running test: " << name << std::endl;
         }
 
         test_func();
+        elapsed_ms = (Timer::now_ns() - start) / 1e6;
+        if (benchmark) {
+          run_benchmark(timing);
+        }
 
         if (not quiet_mode) {
-          std::cout << "PASS" << std::endl;
+          std::cout << (failure_msg.empty() ? "PASS" : "FAIL") << std::endl;
         }
       }
       catch (TestFailure& failure) {
@@ -321,9 +422,36 @@ namespace unit_test_framework {
           std::cout << "ERROR" << std::endl;
         }
       }
+      if (elapsed_ms < 0) {
+        elapsed_ms = (Timer::now_ns() - start) / 1e6;
+      }
+    }
+
+    // Times the test body and compares it with its baseline, if any.
+    void run_benchmark(const TimingOptions& timing) {
+      ns_per_iteration = Timer::ns_per_call(test_func, timing.bench_ms);
+      auto baseline = timing.baseline.find(name);
+      if (baseline == timing.baseline.end() or
+          ns_per_iteration <= baseline->second * (1 + timing.tolerance)) {
+        return;
+      }
+      std::ostringstream oss;
+      oss << "Benchmark \"" << name << "\" took " << ns_per_iteration
+          << " ns per iteration, more than " << timing.tolerance * 100
+          << "% over its baseline of " << baseline->second << " ns\n";
+      failure_msg = oss.str();
+    }
+
+    void print_time(const TimingOptions& timing) {
+      if (benchmark and ns_per_iteration >= 0) {
+        std::cout << " (" << ns_per_iteration << " ns/iteration)";
+      }
+      else if (timing.report_time) {
+        std::cout << " (" << elapsed_ms << " ms)";
+      }
     }
 
-    void print(bool quiet_mode) {
+    void print(bool quiet_mode, const TimingOptions& timing) {
       if (quiet_mode) {
         std::cout << name << ": ";
       }
@@ -332,7 +460,9 @@ namespace unit_test_framework {
       }
 
       if (not failure_msg.empty()) {
-        std::cout << "FAIL" << std::endl;
+        std::cout << "FAIL";
+        print_time(timing);
+        std::cout << std::endl;
         if (not quiet_mode) {
           std::cout << failure_msg << std::endl;
         }
@@ -344,14 +474,19 @@ namespace unit_test_framework {
         }
       }
       else {
-        std::cout << "PASS" << std::endl;
+        std::cout << "PASS";
+        print_time(timing);
+        std::cout << std::endl;
       }
     }
 
     std::string name;
     Test_func_t test_func;
+    bool benchmark;
     std::string failure_msg{};
     std::string exception_msg{};
+    double elapsed_ms = -1;
+    double ns_per_iteration = -1;
   };
 
 
@@ -364,8 +499,13 @@ namespace unit_test_framework {
       return *instance;
     }
 
-    void add_test(const std::string& test_name, Test_func_t test) {
-      tests_.insert({test_name, TestCase{test_name, test}});
+    void add_test(const std::string& test_name, Test_func_t test,
+                  bool benchmark = false) {
+      tests_.insert({test_name, TestCase{test_name, test, benchmark}});
+    }
+
+    const TimingOptions& timing() const {
+      return timing_;
     }
 
     int run_tests(int argc, char** argv) {
@@ -384,13 +524,29 @@ namespace unit_test_framework {
         }
       }
 
-      for (auto test_name : test_names_to_run) {
-        tests_.at(test_name).run(quiet_mode);
+      const double start = Timer::now_ns();
+#if UNIT_TEST_CAN_FORK
+      if (jobs > 1) {
+        run_parallel(test_names_to_run);
       }
+      else
+#endif
+      {
+        for (auto test_name : test_names_to_run) {
+          tests_.at(test_name).run(quiet_mode, timing_);
+        }
+      }
+      const double wall_ms = (Timer::now_ns() - start) / 1e6;
 
       std::cout << "\n*** Results ***" << std::endl;
       for (auto test_name : test_names_to_run) {
-        tests_.at(test_name).print(quiet_mode);
+        tests_.at(test_name).print(quiet_mode, timing_);
+      }
+
+      if (not timing_.save_path.empty() and
+          not save_baseline(test_names_to_run)) {
+        std::cout << "Error opening " << timing_.save_path << std::endl;
+        return 1;
       }
 
       auto num_failures =
@@ -410,6 +566,9 @@ namespace unit_test_framework {
                   << " tests run:" << std::endl;
         std::cout << num_failures << " failure(s), " << num_errors
                   << " error(s)" << std::endl;
+        if (timing_.report_time) {
+          std::cout << "Wall time: " << wall_ms << " ms" << std::endl;
+        }
       }
 
       if (num_failures == 0 and num_errors == 0) {
@@ -424,6 +583,31 @@ namespace unit_test_framework {
       quiet_mode = true;
     }
 
+    // Writes the time per iteration of each benchmark that ran and
+    // passed, one "name nanoseconds" line each.
+    bool save_baseline(const std::vector<std::string>& test_names) {
+      std::ofstream out(timing_.save_path);
+      for (const auto& test_name : test_names) {
+        const TestCase& test = tests_.at(test_name);
+        if (test.benchmark and test.failure_msg.empty() and
+            test.exception_msg.empty()) {
+          out << test_name << ' ' << test.ns_per_iteration << '\n';
+        }
+      }
+      return bool(out);
+    }
+
+    // Reads a baseline written by save_baseline.
+    bool load_baseline(const std::string& path) {
+      std::ifstream in(path);
+      std::string test_name;
+      double ns = 0;
+      while (in >> test_name >> ns) {
+        timing_.baseline[test_name] = ns;
+      }
+      return in.eof();
+    }
+
     std::ostream& print_test_names(std::ostream& os) {
       for (const auto& test_pair : tests_) {
         os << test_pair.first << '\n';
@@ -450,6 +634,205 @@ namespace unit_test_framework {
     bool operator=(const TestSuite&) = delete;
     ~TestSuite() {}
 
+#if UNIT_TEST_CAN_FORK
+    // Runs test_names in jobs worker processes, test i in worker
+    // i % jobs, so a test that crashes takes down only its worker; the
+    // tests that worker had left run again in new workers.  Each test's
+    // output is captured and printed afterwards in the order of
+    // test_names, so the output is the same however many jobs run.
+    // Benchmarks are timed in this process after the workers finish, one
+    // at a time, so the workers do not slow them down.
+    void run_parallel(const std::vector<std::string>& test_names) {
+      std::vector<std::string> pending;
+      std::vector<std::string> benchmarks;
+      for (const auto& test_name : test_names) {
+        (tests_.at(test_name).benchmark ? benchmarks : pending).push_back(test_name);
+      }
+      std::map<std::string, std::string> outputs;
+      while (not pending.empty()) {
+        run_workers(pending, outputs);
+        std::vector<std::string> left;
+        for (const auto& test_name : pending) {
+          if (outputs.find(test_name) == outputs.end()) {
+            left.push_back(test_name);
+          }
+        }
+        // no worker could start, so the tests run here
+        if (left.size() == pending.size()) {
+          for (const auto& test_name : left) {
+            outputs[test_name] = run_captured(tests_.at(test_name));
+          }
+          left.clear();
+        }
+        pending.swap(left);
+      }
+      for (const auto& test_name : benchmarks) {
+        outputs[test_name] = run_captured(tests_.at(test_name));
+      }
+      for (const auto& test_name : test_names) {
+        std::cout << outputs[test_name] << std::flush;
+      }
+    }
+
+    // Runs test_names in up to jobs workers and waits for them, adding
+    // the output of each test that finished or crashed to outputs.
+    void run_workers(const std::vector<std::string>& test_names,
+                     std::map<std::string, std::string>& outputs) {
+      const int workers = std::min<int>(jobs, test_names.size());
+      std::vector<std::FILE*> files;
+      std::vector<pid_t> pids;
+      std::cout << std::flush;
+      for (int worker = 0; worker < workers; ++worker) {
+        std::FILE* file = std::tmpfile();
+        const pid_t pid = file ? fork() : -1;
+        if (pid == 0) {
+          run_shard(test_names, worker, workers, file);
+        }
+        files.push_back(file);
+        pids.push_back(pid);
+      }
+      for (int worker = 0; worker < workers; ++worker) {
+        int status = 0;
+        if (pids[worker] > 0 and waitpid(pids[worker], &status, 0) > 0) {
+          read_shard(files[worker], status, outputs);
+        }
+        if (files[worker]) {
+          std::fclose(files[worker]);
+        }
+      }
+    }
+
+    // Runs test with its output going to a string, and returns the string.
+    std::string run_captured(TestCase& test) {
+      std::ostringstream output;
+      std::streambuf* const stdout_buf = std::cout.rdbuf(output.rdbuf());
+      test.run(quiet_mode, timing_);
+      std::cout.rdbuf(stdout_buf);
+      return output.str();
+    }
+
+    // Runs test_names shard, shard + shards, ... in a worker, writing a
+    // start record and then a result record for each to file, and exits.
+    [[noreturn]] void run_shard(const std::vector<std::string>& test_names,
+                                int shard, int shards, std::FILE* file) {
+      for (std::size_t i = shard; i < test_names.size(); i += shards) {
+        TestCase& test = tests_.at(test_names[i]);
+        write_field(file, "S");
+        write_field(file, test.name);
+        std::fflush(file);
+        const std::string output = run_captured(test);
+        std::ostringstream elapsed;
+        elapsed.precision(17);
+        elapsed << test.elapsed_ms;
+        for (const std::string& field : {std::string("R"), output,
+                                         test.failure_msg, test.exception_msg,
+                                         elapsed.str()}) {
+          write_field(file, field);
+        }
+        std::fflush(file);
+      }
+      std::fclose(file);
+      // no atexit handlers or destructors: they belong to the parent
+      std::_Exit(0);
+    }
+
+    // Reads the records a worker that ended with status wrote to file.  A
+    // test it started and did not finish is where it crashed.
+    void read_shard(std::FILE* file, int status,
+                    std::map<std::string, std::string>& outputs) {
+      std::rewind(file);
+      std::string kind;
+      std::string running;
+      while (read_field(file, kind)) {
+        if (kind == "S") {
+          if (not read_field(file, running)) {
+            break;
+          }
+          continue;
+        }
+        if (kind != "R" or running.empty()) {
+          break;
+        }
+        TestCase& test = tests_.at(running);
+        std::string elapsed;
+        if (not read_field(file, outputs[running]) or
+            not read_field(file, test.failure_msg) or
+            not read_field(file, test.exception_msg) or
+            not read_field(file, elapsed)) {
+          break;
+        }
+        test.elapsed_ms = std::atof(elapsed.c_str());
+        running.clear();
+      }
+      if (running.empty()) {
+        return;
+      }
+      std::ostringstream oss;
+      oss << "Test \"" << running << "\" stopped its worker: ";
+      if (WIFSIGNALED(status)) {
+        oss << "killed by signal " << WTERMSIG(status) << '\n';
+      }
+      else {
+        oss << "exit status " << WEXITSTATUS(status) << '\n';
+      }
+      TestCase& test = tests_.at(running);
+      test.exception_msg = oss.str();
+      outputs[running] = quiet_mode ? "" : "Running test: " + running + "\nERROR\n";
+    }
+
+    static void write_field(std::FILE* file, const std::string& field) {
+      std::fprintf(file, "%zu\n", field.size());
+      std::fwrite(field.data(), 1, field.size(), file);
+    }
+
+    static bool read_field(std::FILE* file, std::string& field) {
+      std::size_t size = 0;
+      if (std::fscanf(file, "%zu", &size) != 1 or std::fgetc(file) != '\n') {
+        return false;
+      }
+      field.resize(size);
+      return std::fread(&field[0], 1, size, file) == size;
+    }
+#endif
+
+    // Reads the value of the option at argv[i] and moves i past it.
+    static std::string option_value(int argc, char** argv, int& i) {
+      if (i + 1 >= argc) {
+        std::cout << "missing value for " << argv[i] << std::endl;
+        throw ExitSuite(1);
+      }
+      return argv[++i];
+    }
+
+    void parse_timing_option(int argc, char** argv, int& i) {
+      const std::string option = argv[i];
+      if (option == "--time" or option == "-t") {
+        timing_.report_time = true;
+      }
+      else if (option == "--baseline" or option == "-b") {
+        const std::string path = option_value(argc, argv, i);
+        if (not load_baseline(path)) {
+          std::cout << "Error opening " << path << std::endl;
+          throw ExitSuite(1);
+        }
+      }
+      else if (option == "--save-baseline") {
+        timing_.save_path = option_value(argc, argv, i);
+      }
+      else if (option == "--tolerance") {
+        timing_.tolerance = std::atof(option_value(argc, argv, i).c_str()) / 100;
+      }
+      else if (option == "--bench-ms") {
+        timing_.bench_ms = std::atof(option_value(argc, argv, i).c_str());
+      }
+    }
+
+    static bool is_timing_option(const std::string& option) {
+      return option == "--time" or option == "-t" or option == "--baseline" or
+        option == "-b" or option == "--save-baseline" or
+        option == "--tolerance" or option == "--bench-ms";
+    }
+
     std::vector<std::string> get_test_names_to_run(int argc, char** argv) {
       std::vector<std::string> test_names_to_run;
 #if UNIT_TEST_ENABLE_REGEXP
@@ -467,6 +850,18 @@ namespace unit_test_framework {
                  argv[i] == std::string("-q")) {
           TestSuite::get().enable_quiet_mode();
         }
+        else if (is_timing_option(argv[i])) {
+          parse_timing_option(argc, argv, i);
+        }
+        else if (argv[i] == std::string("--jobs") or
+                 argv[i] == std::string("-j")) {
+          jobs = std::atoi(option_value(argc, argv, i).c_str());
+#if UNIT_TEST_CAN_FORK
+          if (jobs <= 0) {
+            jobs = static_cast<int>(sysconf(_SC_NPROCESSORS_ONLN));
+          }
+#endif
+        }
 #if UNIT_TEST_ENABLE_REGEXP
         else if (argv[i] == std::string("--regexp") or
                  argv[i] == std::string("-e")) {
@@ -477,9 +872,12 @@ namespace unit_test_framework {
                  argv[i] == std::string("-h")) {
           std::cout << "usage: " << argv[0]
 #if UNIT_TEST_ENABLE_REGEXP
-                    << " [-h] [-e] [-n] [-q] [[TEST_NAME] ...]\n";
+                    << " [-h] [-e] [-n] [-q] [-t] [-j N] [-b FILE]"
+                    << " [--save-baseline FILE]"
+                    << " [--tolerance PERCENT] [--bench-ms MS] [[TEST_NAME] ...]\n";
 #else
-          << " [-h] [-n] [-q] [[TEST_NAME] ...]\n";
+          << " [-h] [-n] [-q] [-t] [-j N] [-b FILE] [--save-baseline FILE]"
+          << " [--tolerance PERCENT] [--bench-ms MS] [[TEST_NAME] ...]\n";
 #endif
           std::cout
             << "optional arguments:\n"
@@ -490,6 +888,16 @@ namespace unit_test_framework {
             << " -n, --show_test_names\t print the names of all "
             "discovered test cases and exit\n"
             << " -q, --quiet\t\t print a reduced summary of test results\n"
+            << " -t, --time\t\t print the wall time each test took\n"
+            << " -j, --jobs N\t\t run tests in N worker processes, or one "
+            "per processor if N is 0\n"
+            << " -b, --baseline FILE\t fail benchmarks slower than the "
+            "times saved in FILE\n"
+            << " --save-baseline FILE\t save the benchmark times to FILE\n"
+            << " --tolerance PERCENT\t slowdown allowed over the baseline "
+            "(default 25)\n"
+            << " --bench-ms MS\t\t time spent measuring each benchmark "
+            "and ASSERT_FASTER_THAN (default 20)\n"
             << " TEST_NAME ...\t\t run only the test cases whose names "
             "are "
             "listed here. Note: If no test names are specified, all "
@@ -537,6 +945,8 @@ namespace unit_test_framework {
     std::map<std::string, TestCase> tests_;
 
     bool quiet_mode = false;
+    int jobs = 1;
+    TimingOptions timing_{};
     static bool incomplete;
   };
 
@@ -549,8 +959,9 @@ namespace unit_test_framework {
 
   class TestRegisterer {
   public:
-    TestRegisterer(const std::string& test_name, Test_func_t test) {
-      TestSuite::get().add_test(test_name, test);
+    TestRegisterer(const std::string& test_name, Test_func_t test,
+                   bool benchmark = false) {
+      TestSuite::get().add_test(test_name, test, benchmark);
     }
   };
 
@@ -730,6 +1141,24 @@ namespace unit_test_framework {
       reason << "Values too far apart: " << first << " and " << second;
       throw TestFailure(reason.str(), line_number, assertion_text);
     }
+
+    template <typename Func, typename Rep, typename Period>
+    static void assert_faster_than(Func&& func,
+                                   std::chrono::duration<Rep, Period> budget,
+                                   int line_number,
+                                   const char* assertion_text) {
+      const double budget_ns =
+        std::chrono::duration<double, std::nano>(budget).count();
+      const double ns = Timer::ns_per_call(
+        func, TestSuite::get().timing().bench_ms);
+      if (ns <= budget_ns) {
+        return;
+      }
+      std::ostringstream reason;
+      reason << "Took " << ns << " ns per evaluation, over the budget of "
+             << budget_ns << " ns";
+      throw TestFailure(reason.str(), line_number, assertion_text);
+    }
   };
 
 } // namespace unit_test_framework